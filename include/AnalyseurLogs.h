@@ -5,23 +5,121 @@
 #ifndef ANALYSEURLOGS_H
 #define ANALYSEURLOGS_H
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
+#include "ClassementFilms.h"
+#include "CompteursRepartis.h"
 #include "GestionnaireFilms.h"
 #include "GestionnaireUtilisateurs.h"
+#include "JournalLogs.h"
 #include "LigneLog.h"
+#include "PublicationEpoques.h"
+#include "StatistiquesLogs.h"
 #include "Tests.h"
 
+/// Struct contenant l'index des vues d'un utilisateur, maintenu au fur et à mesure que des logs sont ajoutés.
+struct VuesUtilisateur
+{
+    int nombreVues = 0;
+    std::unordered_set<IdDense> filmsVus;
+};
+
 /// Classe contenant la liste des entrées du log pour en analyser les tendances pertinentes.
+/// Les compteurs sont des tableaux indexés par les identifiants denses des films et des utilisateurs; un analyseur ne
+/// doit donc recevoir que des logs provenant des mêmes gestionnaires.
 class AnalyseurLogs
 {
 public:
+    /// Classe permettant à un thread producteur d'ajouter des lignes de log à l'analyseur pendant que d'autres
+    /// producteurs en ajoutent aussi (voir creerProducteur). Une vue est comptée dès l'ajout dans des compteurs
+    /// répartis partagés par les producteurs, que les requêtes sur le nombre de vues et sur les films les plus
+    /// populaires additionnent à la lecture; les lignes sont gardées par le producteur et transmises à l'analyseur
+    /// par lots, puis ajoutées au journal, au classement et aux films vus par integrerLignesProduites. Un producteur
+    /// ne doit être utilisé que par un thread à la fois et doit être détruit avant l'analyseur; il transmet ses
+    /// dernières lignes à sa destruction.
+    class Producteur
+    {
+    public:
+        Producteur(const Producteur&) = delete;
+        Producteur(Producteur&& other) noexcept;
+        ~Producteur();
+
+        Producteur& operator=(const Producteur&) = delete;
+        Producteur& operator=(Producteur&&) = delete;
+
+        bool ajouterLigneLog(const LigneLog& ligneLog);
+        void transmettre();
+
+    private:
+        Producteur(AnalyseurLogs& analyseurLogs,
+                   std::size_t numero,
+                   const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                   const GestionnaireFilms& gestionnaireFilms);
+
+        AnalyseurLogs* analyseurLogs_; // nullptr après un déplacement
+        const GestionnaireUtilisateurs* gestionnaireUtilisateurs_;
+        const GestionnaireFilms* gestionnaireFilms_;
+        std::size_t numero_;              // Ordre de création, qui donne le fragment des compteurs répartis
+        std::vector<LigneLog> lignesLog_; // Comptées mais pas encore transmises
+
+        friend class AnalyseurLogs;
+    };
+
     // Opérations d'ajout de logs
     bool chargerDepuisFichier(const std::string& nomFichier, GestionnaireUtilisateurs& gestionnaireUtilisateurs,
                               GestionnaireFilms& gestionnaireFilms);
     bool creerLigneLog(const std::string& timestamp, const std::string& idUtilisateur, const std::string& nomFilm,
                        GestionnaireUtilisateurs& gestionnaireUtilisateurs, GestionnaireFilms& gestionnaireFilms);
-    void ajouterLigneLog(const LigneLog& ligneLog);
+    bool ajouterLigneLog(const LigneLog& ligneLog, const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                         const GestionnaireFilms& gestionnaireFilms);
+    bool ajouterLignesLog(std::vector<LigneLog> lignesLog, const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                          const GestionnaireFilms& gestionnaireFilms);
+    bool ajouterLotsLog(std::vector<std::vector<LigneLog>> lotsLog,
+                        const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                        const GestionnaireFilms& gestionnaireFilms);
+
+    // Ajout par plusieurs threads producteurs
+    Producteur creerProducteur(const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                               const GestionnaireFilms& gestionnaireFilms);
+    std::size_t integrerLignesProduites();
+
+    // Renumérotation après la compaction des gestionnaires
+    std::size_t renumeroterIdsDenses(const std::vector<IdDense>& nouveauxIdsUtilisateurs,
+                                     const std::vector<IdDense>& nouveauxIdsFilms,
+                                     const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                     const GestionnaireFilms& gestionnaireFilms);
+
+    // Lecture en continu
+    bool suivreFichier(const std::string& nomFichier, const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                       const GestionnaireFilms& gestionnaireFilms);
+
+    // Instantanés
+    bool sauvegarderInstantane(const std::string& nomFichier) const;
+    bool chargerInstantane(const std::string& nomFichier, const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                           const GestionnaireFilms& gestionnaireFilms);
+
+    // Configuration du chargement
+    void setNombreThreads(unsigned int nombreThreads);
+    unsigned int getNombreThreads() const;
+
+    // Configuration de l'ajout en continu
+    void setRetardMaximal(Timestamp retardMaximal);
+    Timestamp getRetardMaximal() const;
+    void publierLignesEnAttente();
+    std::size_t getNombreLignesEnAttente() const;
+    std::size_t getNombreLignesEnRetard() const;
+
+    // Lecture concurrente
+    void activerPublication();
+    void publierStatistiques();
+    std::optional<PublicationEpoques<StatistiquesLogs>::Lecteur> creerLecteur() const;
 
     // Statistiques
     int getNombreVuesFilm(const Film* film) const;
@@ -30,9 +128,81 @@ public:
     int getNombreVuesPourUtilisateur(const Utilisateur* utilisateur) const;
     std::vector<const Film*> getFilmsVusParUtilisateur(const Utilisateur* utilisateur) const;
 
+    // Statistiques sur un intervalle de temps
+    int getNombreVuesFilmEntre(const Film* film, Timestamp debut, Timestamp fin) const;
+    std::vector<std::pair<const Film*, int>> getNFilmsPlusPopulairesEntre(std::size_t nombre, Timestamp debut,
+                                                                         Timestamp fin) const;
+    int getNombreVuesPourUtilisateurEntre(const Utilisateur* utilisateur, Timestamp debut, Timestamp fin) const;
+
 private:
-    std::vector<LigneLog> logs_;
-    std::unordered_map<const Film*, int> vuesFilms_;
+    /// Struct contenant l'état de la publication aux threads lecteurs. Une copie de l'analyseur ne partage pas ses
+    /// lecteurs: la copie d'un analyseur commence sans publication, et un analyseur qui reçoit une copie garde sa
+    /// publication et y publie le contenu copié à la prochaine publication.
+    struct EtatPublication
+    {
+        EtatPublication() = default;
+        EtatPublication(const EtatPublication&);
+        EtatPublication(EtatPublication&&) = default;
+        EtatPublication& operator=(const EtatPublication&);
+        EtatPublication& operator=(EtatPublication&&) = default;
+
+        std::unique_ptr<PublicationEpoques<StatistiquesLogs>> publication; // nullptr tant qu'elle n'est pas activée
+        std::vector<LigneLog> lignesNonPubliees; // Comptées depuis la dernière publication
+        bool journalAPublier = true;             // True si le journal doit être republié au complet
+    };
+
+    /// Struct contenant l'état partagé avec les producteurs. Une copie de l'analyseur garde les vues comptées par les
+    /// producteurs et les lots transmis, mais pas les producteurs eux-mêmes; aucun producteur ne doit ajouter de ligne
+    /// pendant la copie.
+    struct EtatProducteurs
+    {
+        EtatProducteurs() = default;
+        EtatProducteurs(const EtatProducteurs& other);
+        EtatProducteurs& operator=(const EtatProducteurs& other);
+
+        void reinitialiser();
+
+        std::unique_ptr<CompteursRepartis> vuesFilms;        // nullptr avant le premier producteur
+        std::unique_ptr<CompteursRepartis> vuesUtilisateurs; // Nombre de vues seulement
+        std::atomic<std::size_t> nombreProducteurs{0};       // Producteurs non détruits
+        std::size_t prochainNumero = 0;
+        mutable std::mutex mutexLots;
+        std::vector<std::pair<std::size_t, std::vector<LigneLog>>> lotsTransmis; // Numéro du producteur et lignes
+    };
+
+    void associerGestionnaires(const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                               const GestionnaireFilms& gestionnaireFilms);
+    void mettreEnAttente(const LigneLog& ligneLog);
+    void publierDans(JournalLogs& logs) const;
+    template<typename Fonction>
+    void pourChaqueLigneNonPubliee(Timestamp debut, Timestamp fin, Fonction fonction) const;
+    bool enregistrerLigneLog(const LigneLog& ligneLog, const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                             const GestionnaireFilms& gestionnaireFilms);
+    void compterVue(const LigneLog& ligneLog);
+    bool aVuesProduites() const;
+    std::vector<std::pair<IdDense, int>> getPremiersFilms(std::size_t nombre) const;
+    IdDense getIdFilm(const Film* film) const;
+    IdDense getIdUtilisateur(const Utilisateur* utilisateur) const;
+
+    JournalLogs logs_;
+    std::vector<const Film*> films_;               // Identifiant dense -> film, nullptr si inconnu de l'analyseur
+    std::vector<const Utilisateur*> utilisateurs_; // Identifiant dense -> utilisateur
+    std::vector<int> vuesFilms_;                   // Indexé par identifiant dense de film
+    ClassementFilms classementFilms_;
+    std::vector<VuesUtilisateur> vuesUtilisateurs_; // Indexé par identifiant dense d'utilisateur
+
+    unsigned int nombreThreads_ = 0; // 0 pour utiliser autant de threads que de coeurs
+
+    Timestamp retardMaximal_ = 0;           // 0 pour insérer chaque ligne à sa place dès son ajout
+    std::vector<LigneLog> lignesEnAttente_; // Triées, toutes au moins aussi récentes que la dernière ligne de logs_
+    std::vector<LigneLog> lignesEnRetard_;  // Plus anciennes que la dernière ligne de logs_ à leur arrivée
+    std::size_t nombreLignesEnRetard_ = 0;
+
+    std::string fichierSuivi_;        // Le dernier fichier chargé ou suivi
+    std::uint64_t positionSuivi_ = 0; // Position après la dernière ligne complète lue dans fichierSuivi_
+
+    EtatPublication publication_;
+    EtatProducteurs producteurs_;
 
     friend double Tests::testAnalyseurLogs(); // Pour les tests
 };
@@ -0,0 +1,92 @@
+/// Arène de chaînes de caractères.
+/// \date 2026-10-17
+
+#ifndef ARENACHAINES_H
+#define ARENACHAINES_H
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/// Chaîne immuable dont les caractères sont dans un bloc partagé, le plus souvent celui d'une ArenaChaines. Chaque
+/// chaîne garde son bloc en vie: ses caractères restent valides tant qu'une copie de la chaîne existe, même après la
+/// destruction de l'arène qui l'a créée. Une copie ne copie pas les caractères. Une chaîne construite directement à
+/// partir d'une autre chaîne a son propre bloc, à la taille exacte de ses caractères.
+class ChaineArena
+{
+public:
+    ChaineArena() = default;
+    ChaineArena(std::string_view chaine);
+    ChaineArena(const std::string& chaine);
+    ChaineArena(const char* chaine);
+
+    operator std::string_view() const;
+    const char* data() const;
+    std::size_t size() const;
+    bool empty() const;
+
+    friend bool operator==(const ChaineArena& chaine, const ChaineArena& autre);
+
+    template<typename T, typename = std::enable_if_t<std::is_convertible_v<const T&, std::string_view> &&
+                                                     !std::is_same_v<T, ChaineArena>>>
+    friend bool operator==(const ChaineArena& chaine, const T& autre)
+    {
+        return std::string_view(chaine) == std::string_view(autre);
+    }
+
+    template<typename T, typename = std::enable_if_t<std::is_convertible_v<const T&, std::string_view> &&
+                                                     !std::is_same_v<T, ChaineArena>>>
+    friend bool operator==(const T& autre, const ChaineArena& chaine)
+    {
+        return std::string_view(autre) == std::string_view(chaine);
+    }
+
+    template<typename T>
+    friend bool operator!=(const ChaineArena& chaine, const T& autre)
+    {
+        return !(chaine == autre);
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_same_v<T, ChaineArena>>>
+    friend bool operator!=(const T& autre, const ChaineArena& chaine)
+    {
+        return !(autre == chaine);
+    }
+
+    friend std::ostream& operator<<(std::ostream& outputStream, const ChaineArena& chaine);
+
+private:
+    friend class ArenaChaines;
+
+    ChaineArena(std::shared_ptr<const char> caracteres, std::size_t taille);
+
+    std::shared_ptr<const char> caracteres_; // Pointe dans le bloc, dont il partage le compte de références
+    std::size_t taille_ = 0;
+};
+
+/// Classe qui copie des chaînes les unes à la suite des autres dans de grands blocs de mémoire, pour remplacer une
+/// allocation par chaîne. Le premier bloc n'est alloué qu'au premier ajout, et chaque bloc a le double de la taille du
+/// précédent jusqu'à une taille maximale; une chaîne trop longue pour partager un bloc a le sien. L'arène ne garde que
+/// son dernier bloc: les blocs précédents appartiennent aux chaînes qu'ils contiennent et sont rendus avec la dernière
+/// d'entre elles. L'espace d'une chaîne détruite n'est pas réutilisé tant que son bloc est en vie.
+class ArenaChaines
+{
+public:
+    explicit ArenaChaines(std::size_t tailleBloc = 16 * 1024, std::size_t taillePremierBloc = 256);
+
+    ChaineArena ajouter(std::string_view chaine);
+    std::size_t getNombreBlocs() const;
+
+private:
+    std::shared_ptr<char[]> dernierBloc_;
+    std::size_t tailleDernierBloc_ = 0;
+    std::size_t positionDernierBloc_ = 0;
+    std::size_t nombreBlocs_ = 0;
+    std::size_t tailleBloc_;
+    std::size_t taillePremierBloc_;
+};
+
+#endif // ARENACHAINES_H
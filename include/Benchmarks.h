@@ -0,0 +1,27 @@
+/// Mesures de performance.
+/// \date 2026-10-17
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#define BENCHMARK_CHARGEMENT_LOGS_ACTIF false
+#define BENCHMARK_NOYAUX_COMPTAGE_ACTIF false
+#define BENCHMARK_ENSEMBLES_BITS_ACTIF false
+#define BENCHMARK_REDACTEUR_RAPPORT_ACTIF false
+#define BENCHMARK_INSTANTANES_ACTIF false
+#define BENCHMARK_LIGNES_EN_RETARD_ACTIF false
+#define BENCHMARK_COMPTEURS_REPARTIS_ACTIF false
+
+namespace Benchmarks
+{
+    void benchAll();
+    void benchChargementLogs();
+    void benchNoyauxComptage();
+    void benchEnsemblesBits();
+    void benchRedacteurRapport();
+    void benchInstantanes();
+    void benchLignesEnRetard();
+    void benchCompteursRepartis();
+} // namespace Benchmarks
+
+#endif // BENCHMARKS_H
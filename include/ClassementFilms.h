@@ -0,0 +1,37 @@
+/// Classement des films par nombre de vues.
+/// \date 2026-10-17
+
+#ifndef CLASSEMENTFILMS_H
+#define CLASSEMENTFILMS_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "IdDense.h"
+
+/// Classe qui garde les identifiants denses des films triés par nombre de vues décroissant pendant que les vues sont
+/// comptées. Les films ayant le même nombre de vues forment un groupe contigu dont on connaît le début, ce qui permet
+/// de déplacer un film vers le groupe précédent par un seul échange lorsque son nombre de vues augmente de 1.
+class ClassementFilms
+{
+public:
+    // Opérations de mise à jour
+    void incrementer(IdDense idFilm);
+    void reconstruire(const std::vector<int>& vuesFilms);
+    void vider();
+
+    // Getters
+    bool estVide() const;
+    IdDense getPremier() const;
+    std::vector<std::pair<IdDense, int>> getPremiers(std::size_t nombre) const;
+
+private:
+    static constexpr std::size_t positionInvalide = static_cast<std::size_t>(-1);
+
+    std::vector<std::pair<IdDense, int>> films_; // En ordre décroissant de vues
+    std::vector<std::size_t> positions_;         // Identifiant dense -> position dans films_
+    std::unordered_map<int, std::size_t> debutsGroupes_; // Nombre de vues -> position du premier film du groupe
+};
+
+#endif // CLASSEMENTFILMS_H
@@ -0,0 +1,56 @@
+/// Compteurs répartis entre plusieurs threads producteurs.
+/// \date 2026-10-17
+
+#ifndef COMPTEURSREPARTIS_H
+#define COMPTEURSREPARTIS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Classe contenant un tableau de compteurs que plusieurs threads modifient en même temps. Chaque producteur écrit dans
+/// le fragment de son numéro modulo le nombre de fragments, une copie complète du tableau qui commence sur sa propre
+/// ligne de cache: deux producteurs de fragments différents ne se disputent jamais une ligne de cache. Les producteurs
+/// en surplus partagent un fragment, d'où les additions atomiques relâchées. La valeur d'un compteur est la somme de
+/// ses fragments, calculée à chaque lecture; le nombre de fragments est borné pour que cette somme reste bon marché.
+class CompteursRepartis
+{
+public:
+    /// Nombre maximal de fragments. Les producteurs au-delà se partagent les fragments.
+    static constexpr std::size_t nombreMaximalFragments = 16;
+
+    CompteursRepartis(std::size_t nombreCompteurs, std::size_t nombreFragments);
+    CompteursRepartis(const CompteursRepartis& other);
+
+    CompteursRepartis& operator=(const CompteursRepartis&) = delete;
+
+    // Opérations des producteurs
+    void incrementer(std::size_t index, std::size_t producteur);
+    void decrementer(std::size_t index, std::size_t producteur);
+
+    // Lecture
+    std::size_t getNombreCompteurs() const;
+    std::size_t getNombreFragments() const;
+    std::int64_t getTotal(std::size_t index) const;
+
+private:
+    static constexpr std::size_t compteursParLigne = 16;
+
+    /// Ligne de cache de compteurs. Un fragment occupe des lignes entières.
+    struct alignas(64) LigneCompteurs
+    {
+        std::atomic<std::int32_t> compteurs[compteursParLigne]{};
+    };
+
+    static_assert(sizeof(LigneCompteurs) == 64, "Une ligne de compteurs doit occuper exactement une ligne de cache");
+
+    std::atomic<std::int32_t>& getCompteur(std::size_t index, std::size_t producteur);
+
+    std::size_t nombreCompteurs_;
+    std::size_t nombreFragments_;
+    std::size_t lignesParFragment_;
+    std::vector<LigneCompteurs> lignes_;
+};
+
+#endif // COMPTEURSREPARTIS_H
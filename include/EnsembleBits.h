@@ -0,0 +1,65 @@
+/// Ensemble d'identifiants denses sous forme de bits.
+/// \date 2026-10-17
+
+#ifndef ENSEMBLEBITS_H
+#define ENSEMBLEBITS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "IdDense.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// Ensemble d'identifiants denses représenté par un bit par identifiant, regroupés en mots de 64 bits. L'union et
+/// l'intersection se font un mot à la fois et le nombre d'éléments se compte avec popcount.
+class EnsembleBits
+{
+public:
+    void ajouter(IdDense id);
+    void retirer(IdDense id);
+    bool contient(IdDense id) const;
+    std::size_t compter() const;
+    void vider();
+
+    EnsembleBits& operator|=(const EnsembleBits& other);
+    EnsembleBits& operator&=(const EnsembleBits& other);
+
+    /// Appelle une fonction sur chaque identifiant de l'ensemble, en ordre croissant.
+    /// \param fonction     La fonction, appelée avec chaque identifiant.
+    template<typename Fonction>
+    void pourChaque(Fonction&& fonction) const
+    {
+        for (std::size_t indexMot = 0; indexMot < mots_.size(); indexMot++)
+        {
+            std::uint64_t mot = mots_[indexMot];
+            while (mot != 0)
+            {
+                fonction(static_cast<IdDense>(indexMot * bitsParMot + compterZerosFinaux(mot)));
+                mot &= mot - 1;
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t bitsParMot = 64;
+
+    /// Retourne la position du bit à 1 le moins significatif d'un mot non nul.
+    /// \param mot  Le mot, qui ne doit pas être nul.
+    /// \return     Le nombre de bits à 0 sous le premier bit à 1.
+    static std::size_t compterZerosFinaux(std::uint64_t mot)
+    {
+#ifdef _MSC_VER
+        unsigned long position;
+        _BitScanForward64(&position, mot);
+        return position;
+#else
+        return static_cast<std::size_t>(__builtin_ctzll(mot));
+#endif
+    }
+
+    std::vector<std::uint64_t> mots_;
+};
+
+#endif // ENSEMBLEBITS_H
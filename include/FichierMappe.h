@@ -0,0 +1,36 @@
+/// Fichier projeté en mémoire en lecture seule.
+/// \date 2026-10-17
+
+#ifndef FICHIERMAPPE_H
+#define FICHIERMAPPE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/// Classe qui projette le contenu d'un fichier en mémoire (mmap) pour le lire sans copie. Le contenu reste valide tant
+/// que l'objet existe.
+class FichierMappe
+{
+public:
+    // Fonctions membres spéciales
+    explicit FichierMappe(const std::string& nomFichier);
+    FichierMappe(const FichierMappe&) = delete;
+    FichierMappe(FichierMappe&& other) noexcept;
+    FichierMappe& operator=(const FichierMappe&) = delete;
+    FichierMappe& operator=(FichierMappe&& other) noexcept;
+    ~FichierMappe();
+
+    // Getters
+    bool estOuvert() const;
+    std::string_view getContenu() const;
+
+private:
+    void fermer();
+
+    const char* donnees_ = nullptr;
+    std::size_t taille_ = 0;
+    bool estOuvert_ = false;
+};
+
+#endif // FICHIERMAPPE_H
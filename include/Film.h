@@ -5,8 +5,13 @@
 #ifndef FILM_H
 #define FILM_H
 
+#include <array>
+#include <cstddef>
 #include <iostream>
-#include <string>
+#include <optional>
+#include <string_view>
+#include "ArenaChaines.h"
+#include "IdDense.h"
 #include "Pays.h"
 
 /// Struct contenant les caractéristiques pour un film.
@@ -26,14 +31,60 @@ struct Film
         ScienceFiction
     };
 
-    std::string nom;
+    ChaineArena nom; // Copié dans l'arène du gestionnaire à l'ajout
     Genre genre;
     Pays pays;
-    std::string realisateur;
+    ChaineArena realisateur;
     int annee;
+    IdDense idDense = idDenseInvalide; // Attribué par GestionnaireFilms
 };
 
-std::string getGenreString(Film::Genre genre);
+/// Noms des genres, indexés par la valeur de l'enum Film::Genre.
+constexpr std::array<std::string_view, 9> nomsGenres = {"Action",
+                                                        "Aventure",
+                                                        "Comédie",
+                                                        "Documentaire",
+                                                        "Drame",
+                                                        "Fantastique",
+                                                        "Horreur",
+                                                        "Romance",
+                                                        "Science-fiction"};
+constexpr std::size_t nombreGenres = nomsGenres.size();
+static_assert(static_cast<std::size_t>(Film::Genre::ScienceFiction) + 1 == nombreGenres,
+              "Un genre n'a pas de nom dans nomsGenres");
+
+/// Indique si une valeur du enum Film::Genre est l'un des genres nommés, par exemple après la conversion d'un entier.
+/// \param genre    Le genre à vérifier.
+/// \return         True si le genre a un nom dans nomsGenres, false sinon.
+constexpr bool estGenreValide(Film::Genre genre)
+{
+    return static_cast<std::size_t>(genre) < nombreGenres;
+}
+
+/// Convertit la valeur du enum Film::Genre en string.
+/// \param genre    Le genre à convertir.
+/// \return         String représentant le enum, qui pointe dans une table statique.
+constexpr std::string_view getGenreString(Film::Genre genre)
+{
+    auto index = static_cast<std::size_t>(genre);
+    return index < nombreGenres ? nomsGenres[index] : "Erreur";
+}
+
+/// Trouve le genre qui correspond à un nom.
+/// \param nom  Le nom du genre, tel que retourné par getGenreString.
+/// \return     Le genre, ou std::nullopt si aucun genre n'a ce nom.
+constexpr std::optional<Film::Genre> getGenreDepuisString(std::string_view nom)
+{
+    for (std::size_t index = 0; index < nombreGenres; index++)
+    {
+        if (nomsGenres[index] == nom)
+        {
+            return static_cast<Film::Genre>(index);
+        }
+    }
+    return std::nullopt;
+}
+
 std::ostream& operator<<(std::ostream& outputStream, const Film& film);
 
 #endif // FILM_H
@@ -7,6 +7,8 @@
 #ifndef FONCTEUR_H
 #define FONCTEUR_H
 
+#include <memory>
+#include "Film.h"
 #include "LigneLog.h"
 
 class EstDansIntervalleDatesFilm {
@@ -19,6 +21,9 @@ public:
 	bool operator()(const std::unique_ptr<Film>& film) {
 		return (film->annee >= borneInf_ && film->annee <= borneSup_);
 	};
+	bool operator()(const Film* film) {
+		return (film->annee >= borneInf_ && film->annee <= borneSup_);
+	};
 private:
 	int borneInf_;
 	int borneSup_;
@@ -5,21 +5,42 @@
 #ifndef GESTIONNAIREFILMS_H
 #define GESTIONNAIREFILMS_H
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
+#include "ArenaChaines.h"
+#include "EnsembleBits.h"
 #include "Film.h"
+#include "PoolChaines.h"
+#include "PoolObjets.h"
+#include "RequeteFilms.h"
+#include "VueFilms.h"
 
 /// Classe qui gère les informations de tous les films et qui conserve des filtres pour les rechercher rapidement.
+/// Une copie du gestionnaire est un instantané en O(1): elle partage tout son état avec l'original, et une modification
+/// ne copie que les parties qu'elle touche si elles sont encore partagées. Les seaux du filtre par nom, les catégories
+/// et les ensembles de bits sont copiés un à un, mais la liste des films, le répertoire des identifiants denses, les
+/// emplacements et l'index par année sont copiés au complet: la première modification après un instantané coûte donc
+/// O(n), et les suivantes retrouvent leur coût habituel. Les films eux-mêmes ne sont jamais copiés ni déplacés, donc
+/// un instantané garde les mêmes pointeurs et les mêmes identifiants denses que l'original. Un instantané peut être lu
+/// par un autre thread pendant que l'original est modifié, sans verrou.
+/// Les réalisateurs, qui se répètent d'un film à l'autre, sont internés dans une table de chaînes qui peut être
+/// partagée avec un gestionnaire d'utilisateurs et que les instantanés partagent. Les noms des films, uniques, sont
+/// plutôt copiés dans l'arène de leur segment du stockage, pour que leur mémoire soit rendue avec les films supprimés.
 class GestionnaireFilms
 {
 public:
     // Fonctions membres spéciales
     GestionnaireFilms() = default;
-    GestionnaireFilms(const GestionnaireFilms& other);
-    GestionnaireFilms(GestionnaireFilms&&) = default;
-    GestionnaireFilms& operator=(GestionnaireFilms other);
+    explicit GestionnaireFilms(std::shared_ptr<PoolChaines> poolChaines);
+    GestionnaireFilms(const GestionnaireFilms& other); // Instantané en O(1), mais première modification en O(n)
+    GestionnaireFilms(GestionnaireFilms&&) noexcept = default;
+    GestionnaireFilms& operator=(const GestionnaireFilms& other); // Comme le constructeur par copie
+    GestionnaireFilms& operator=(GestionnaireFilms&&) noexcept = default;
 
     // Surcharges d'opérateurs
     friend std::ostream& operator<<(std::ostream& outputStream, const GestionnaireFilms& gestionnaireFilms);
@@ -27,22 +48,111 @@ public:
     // Opérations d'ajout et de suppression
     bool chargerDepuisFichier(const std::string& nomFichier);
     bool ajouterFilm(const Film& film);
-    bool supprimerFilm(const std::string& nomFilm);
+    bool supprimerFilm(std::string_view nomFilm);
+    std::size_t supprimerFilms(const std::vector<std::string_view>& nomsFilms);
+    std::vector<IdDense> compacterIdsDenses();
+
+    // Instantanés
+    bool sauvegarderInstantane(const std::string& nomFichier) const;
+    bool chargerInstantane(const std::string& nomFichier);
 
     // Getters
     std::size_t getNombreFilms() const;
-    const Film* getFilmParNom(const std::string& nom) const;
+    const Film* getFilmParNom(std::string_view nom) const;
+    const Film* getFilmParIdDense(IdDense idDense) const;
+    std::size_t getNombreIdsDenses() const;
     std::vector<const Film*> getFilmsParGenre(Film::Genre genre) const;
     std::vector<const Film*> getFilmsParPays(Pays pays) const;
-    std::vector<const Film*> getFilmsEntreAnnees(int anneeDebut, int anneeFin);
+    VueFilms getVueFilmsParGenre(Film::Genre genre) const;
+    VueFilms getVueFilmsParPays(Pays pays) const;
+    std::vector<const Film*> getFilmsEntreAnnees(int anneeDebut, int anneeFin) const;
+    VueFilms getVueFilmsEntreAnnees(int anneeDebut, int anneeFin) const;
+
+    // Requêtes composées
+    std::size_t rechercherFilms(const RequeteFilms& requete, const std::function<void(const Film*)>& fonction) const;
+    std::size_t compterFilms(const RequeteFilms& requete) const;
+    std::vector<const Film*> getFilms(const RequeteFilms& requete) const;
+
+    // Requêtes sur plusieurs genres et pays
+    EnsembleBits getEnsembleFilms(const std::vector<Film::Genre>& genres, const std::vector<Pays>& pays) const;
+    std::size_t compterFilmsParGenresEtPays(const std::vector<Film::Genre>& genres,
+                                            const std::vector<Pays>& pays) const;
+    std::vector<const Film*> getFilmsParGenresEtPays(const std::vector<Film::Genre>& genres,
+                                                     const std::vector<Pays>& pays) const;
 
 private:
-    std::vector<std::unique_ptr<Film>> films_; // Vecteur de pointeurs pour ne pas que les éléments des filtres
-                                               // deviennent invalidés lors d'un resize du vecteur
+    /// Nombre de seaux du filtre par nom. Une modification après un instantané ne copie qu'un seau.
+    static constexpr std::size_t nombreSeauxNoms = 64;
+
+    /// Seau du filtre par nom. Les clés pointent dans le nom des films du stockage, qui ne sont jamais modifiés.
+    using SeauNoms = std::unordered_map<std::string_view, const Film*>;
+
+    /// Position d'un film dans la liste des films et dans les catégories de son genre et de son pays, pour le retirer
+    /// sans recherche.
+    struct EmplacementFilm
+    {
+        std::size_t positionFilms;
+        std::size_t positionGenre;
+        std::size_t positionPays;
+    };
+
+    /// Films d'un genre ou d'un pays, dans l'ordre d'ajout. Un film retiré laisse un nullptr qui n'est enlevé que
+    /// lorsque la moitié de la catégorie est vide, ce qui garde le retrait en O(1) amorti sans changer l'ordre.
+    struct CategorieFilms
+    {
+        std::vector<const Film*> films;
+        std::size_t nombreRetires = 0;
+    };
+
+    /// Segment du stockage des films. Un segment partagé par plusieurs gestionnaires n'est plus modifié: un
+    /// gestionnaire qui crée un film après un instantané le crée dans un nouveau segment, qui garde les segments
+    /// précédents en vie. Dès que plus aucun instantané ne partage les segments précédents, ils sont absorbés par le
+    /// segment actuel (voir preparerStockage). Les noms des films d'un segment sont copiés dans son arène, dont chaque
+    /// bloc reste en vie tant qu'un film ou une copie de film y pointe.
+    struct StockageFilms
+    {
+        PoolObjets<Film> poolFilms; // Les films ne sont jamais déplacés, pour ne pas invalider les pointeurs
+        ArenaChaines chainesFilms;
+        std::shared_ptr<StockageFilms> precedent;
+    };
+
+    /// État du gestionnaire, dont chaque partie est partagée entre les instantanés jusqu'à sa première modification.
+    struct EtatFilms
+    {
+        EtatFilms();
+
+        std::shared_ptr<StockageFilms> stockage;
+        std::vector<Film*> filmsALiberer; // Supprimés, mais dans un segment qu'un instantané peut encore lire
+        std::shared_ptr<std::vector<Film*>> films;
+        std::shared_ptr<std::vector<const Film*>> filmsParIdDense;  // nullptr pour les films supprimés
+        std::shared_ptr<std::vector<EmplacementFilm>> emplacements; // Indexé par identifiant dense
+        std::array<std::shared_ptr<SeauNoms>, nombreSeauxNoms> filtreNomFilms;
+        std::unordered_map<Film::Genre, std::shared_ptr<CategorieFilms>> filtreGenreFilms;
+        std::unordered_map<Pays, std::shared_ptr<CategorieFilms>> filtrePaysFilms;
+        std::shared_ptr<std::vector<const Film*>> filmsParAnnee; // Triés par année, puis par identifiant dense
+        std::array<std::shared_ptr<EnsembleBits>, nombreGenres> bitsGenres; // Identifiants denses par genre
+        std::array<std::shared_ptr<EnsembleBits>, nombrePays> bitsPays;     // Identifiants denses par pays
+    };
+
+    void vider();
+    bool ajouterFilm(const Film& film, std::string_view nom, std::string_view realisateur);
+    const Film* creerFilm(const Film& film, std::string_view nom, std::string_view realisateur);
+    void libererFilm(Film* film);
+    StockageFilms& preparerStockage(EtatFilms& etat);
+    PoolChaines& getPoolChaines();
+    void retirerDesFiltres(const Film& film, bool compacterCategories);
+    void compacterCategorie(CategorieFilms& categorie, std::size_t EmplacementFilm::*position);
+    const EtatFilms& getEtat() const;
+    EtatFilms& modifierEtat();
+    static std::size_t getSeauNom(std::string_view nom);
+    static std::vector<const Film*>::iterator trouverDansIndexAnnees(std::vector<const Film*>& filmsParAnnee,
+                                                                    const Film& film);
+    static VueFilms getVueCategorie(const CategorieFilms& categorie);
+
+    std::shared_ptr<EtatFilms> etat_;          // nullptr pour un gestionnaire vide
+    std::shared_ptr<PoolChaines> poolChaines_; // Créée au premier ajout si aucune table n'est partagée
 
-    std::unordered_map<std::string, const Film*> filtreNomFilms_;
-    std::unordered_map<Film::Genre, std::vector<const Film*>> filtreGenreFilms_;
-    std::unordered_map<Pays, std::vector<const Film*>> filtrePaysFilms_;
+    friend class RedacteurRapport;
 };
 
 #endif // GESTIONNAIREFILMS_H
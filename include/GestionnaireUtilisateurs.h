@@ -5,14 +5,28 @@
 #ifndef GESTIONNAIREUTILISATEURS_H
 #define GESTIONNAIREUTILISATEURS_H
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
+#include "PoolChaines.h"
+#include "PoolObjets.h"
 #include "Utilisateur.h"
 
-/// Classe qui gère les informations de tous les utilisateurs.
+/// Classe qui gère les informations de tous les utilisateurs. L'identifiant et le nom des utilisateurs sont internés
+/// dans une table de chaînes, qui peut être partagée avec un gestionnaire de films pour ne garder qu'une copie des
+/// chaînes communes. Une copie du gestionnaire partage la table de l'original.
 class GestionnaireUtilisateurs
 {
 public:
+    // Fonctions membres spéciales
+    GestionnaireUtilisateurs() = default;
+    explicit GestionnaireUtilisateurs(std::shared_ptr<PoolChaines> poolChaines);
+    GestionnaireUtilisateurs(const GestionnaireUtilisateurs& other);
+    GestionnaireUtilisateurs(GestionnaireUtilisateurs&&) = default;
+    GestionnaireUtilisateurs& operator=(GestionnaireUtilisateurs other);
+
     // Surcharges d'opérateurs
     friend std::ostream& operator<<(std::ostream& outputStream,
                                     const GestionnaireUtilisateurs& gestionnaireUtilisateurs);
@@ -20,14 +34,30 @@ public:
     // Opérations d'ajout et de suppression
     bool chargerDepuisFichier(const std::string& nomFichier);
     bool ajouterUtilisateur(const Utilisateur& utilisateur);
-    bool supprimerUtilisateur(const std::string& idUtilisateur);
+    bool supprimerUtilisateur(std::string_view idUtilisateur);
+    std::vector<IdDense> compacterIdsDenses();
+
+    // Instantanés
+    bool sauvegarderInstantane(const std::string& nomFichier) const;
+    bool chargerInstantane(const std::string& nomFichier);
 
     // Getters
     std::size_t getNombreUtilisateurs() const;
-    const Utilisateur* getUtilisateurParId(const std::string& id) const;
+    const Utilisateur* getUtilisateurParId(std::string_view id) const;
+    const Utilisateur* getUtilisateurParIdDense(IdDense idDense) const;
+    std::size_t getNombreIdsDenses() const;
 
 private:
-    std::unordered_map<std::string, Utilisateur> utilisateurs_;
+    bool ajouterUtilisateur(const Utilisateur& utilisateur, std::string_view id, std::string_view nom);
+    void vider();
+    PoolChaines& getPoolChaines();
+
+    std::shared_ptr<PoolChaines> poolChaines_; // Créée au premier ajout si aucune table n'est partagée
+    PoolObjets<Utilisateur> poolUtilisateurs_; // Les utilisateurs ne sont jamais déplacés
+    std::unordered_map<std::string_view, Utilisateur*> utilisateurs_; // Clés dans l'identifiant des utilisateurs
+    std::vector<const Utilisateur*> utilisateursParIdDense_; // nullptr pour les utilisateurs supprimés
+
+    friend class RedacteurRapport;
 };
 
 #endif // GESTIONNAIREUTILISATEURS_H
@@ -0,0 +1,21 @@
+/// Identifiants denses des films et des utilisateurs.
+/// \date 2026-10-17
+
+#ifndef IDDENSE_H
+#define IDDENSE_H
+
+#include <cstdint>
+#include <limits>
+
+/// Identifiant attribué par un gestionnaire à chaque élément ajouté, en ordre croissant à partir de 0, pour pouvoir
+/// indexer des tableaux plutôt que des tables de hachage. Un identifiant n'est jamais réutilisé par le même
+/// gestionnaire, même après une suppression, pour que les logs et les compteurs de l'analyseur ne désignent jamais un
+/// autre élément que celui qu'ils ont compté. Les tableaux indexés par identifiant grandissent donc à chaque ajout,
+/// même quand autant d'éléments sont supprimés: compacterIdsDenses renumérote les éléments restants de 0 à n - 1 et
+/// retourne la correspondance à passer à AnalyseurLogs::renumeroterIdsDenses.
+using IdDense = std::uint32_t;
+
+/// Identifiant d'un élément qui n'appartient à aucun gestionnaire.
+constexpr IdDense idDenseInvalide = std::numeric_limits<IdDense>::max();
+
+#endif // IDDENSE_H
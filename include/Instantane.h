@@ -0,0 +1,121 @@
+/// Format binaire des instantanés des gestionnaires et de l'analyseur de logs.
+/// \date 2026-10-17
+
+#ifndef INSTANTANE_H
+#define INSTANTANE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "FichierMappe.h"
+
+/// Contenu d'un instantané, vérifié au chargement pour ne pas charger un instantané de films comme un instantané
+/// d'utilisateurs.
+enum class ContenuInstantane : std::uint32_t
+{
+    Films = 1,
+    Utilisateurs = 2,
+    Logs = 3,
+};
+
+/// Position d'une chaîne dans le bloc de chaînes d'un instantané.
+struct ReferenceChaine
+{
+    std::uint32_t debut;
+    std::uint32_t taille;
+};
+
+/// Bloc de chaînes d'un instantané. Les enregistrements y font référence par position plutôt que de contenir leurs
+/// chaînes, ce qui garde leur taille fixe; une chaîne répétée n'est écrite qu'une fois.
+class BlocChaines
+{
+public:
+    ReferenceChaine ajouter(std::string_view chaine);
+    bool estValide() const;
+    const std::vector<char>& getDonnees() const;
+
+    static bool lireChaine(std::string_view bloc, ReferenceChaine reference, std::string_view& chaine);
+
+private:
+    std::vector<char> donnees_;
+    std::unordered_map<std::string_view, ReferenceChaine> references_; // Clés dans les chaînes ajoutées
+    bool estValide_ = true; // False si le bloc a dépassé la taille adressable par ReferenceChaine
+};
+
+/// Classe qui écrit un instantané: un en-tête (signature, version, contenu, taille et somme de contrôle), une table des
+/// sections puis les sections, chacune alignée sur 8 octets. Une section est un tableau d'enregistrements de taille
+/// fixe copié tel quel, dans l'ordre des octets de la machine.
+class EcrivainInstantane
+{
+public:
+    explicit EcrivainInstantane(ContenuInstantane contenu);
+
+    /// Ajoute une section formée des éléments d'un vecteur. Le vecteur n'est pas copié et doit exister jusqu'à
+    /// l'écriture.
+    /// \param elements     Les éléments de la section.
+    template<typename T>
+    void ajouterSection(const std::vector<T>& elements)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Une section est copiée octet par octet");
+        ajouterSection(elements.data(), elements.size() * sizeof(T));
+    }
+    void ajouterSection(const void* donnees, std::size_t taille);
+
+    bool ecrire(const std::string& nomFichier) const;
+
+private:
+    /// Section à écrire.
+    struct Section
+    {
+        const void* donnees;
+        std::size_t taille;
+    };
+
+    ContenuInstantane contenu_;
+    std::vector<Section> sections_;
+};
+
+/// Classe qui projette un instantané en mémoire et vérifie son en-tête, sa somme de contrôle et sa table des sections.
+/// Les sections sont lues sans interprétation, par une seule copie chacune.
+class LecteurInstantane
+{
+public:
+    LecteurInstantane(const std::string& nomFichier, ContenuInstantane contenu);
+
+    bool estValide() const;
+    std::size_t getNombreSections() const;
+    std::string_view getSection(std::size_t index) const;
+
+    /// Copie une section dans un vecteur.
+    /// \param index        L'index de la section.
+    /// \param elements     Le vecteur qui reçoit les éléments de la section.
+    /// \return             True si la section existe et contient un nombre entier d'éléments, false sinon.
+    template<typename T>
+    bool lireSection(std::size_t index, std::vector<T>& elements) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Une section est copiée octet par octet");
+        if (index >= getNombreSections() || getSection(index).size() % sizeof(T) != 0)
+        {
+            return false;
+        }
+        std::string_view section = getSection(index);
+        elements.resize(section.size() / sizeof(T));
+        if (!section.empty())
+        {
+            std::memcpy(elements.data(), section.data(), section.size());
+        }
+        return true;
+    }
+
+private:
+    FichierMappe fichier_;
+    std::vector<std::string_view> sections_;
+    bool estValide_ = false;
+};
+
+#endif // INSTANTANE_H
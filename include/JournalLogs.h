@@ -0,0 +1,45 @@
+/// Stockage en colonnes des lignes du log.
+/// \date 2026-10-17
+
+#ifndef JOURNALLOGS_H
+#define JOURNALLOGS_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "IdDense.h"
+#include "LigneLog.h"
+
+/// Classe qui garde les lignes du log en ordre chronologique sous forme de colonnes contiguës (une pour les timestamps,
+/// une pour les identifiants des utilisateurs et une pour les identifiants des films) plutôt que sous forme de vecteur
+/// de LigneLog. Une requête qui ne lit qu'un champ ne parcourt ainsi que la colonne de ce champ.
+class JournalLogs
+{
+public:
+    // Opérations d'ajout
+    void reserver(std::size_t capacite);
+    void ajouterALaFin(const LigneLog& ligneLog);
+    void inserer(const LigneLog& ligneLog);
+    void fusionner(std::vector<LigneLog> lignesLog);
+    void vider();
+    bool assigner(std::vector<Timestamp> timestamps, std::vector<IdDense> idsUtilisateurs,
+                  std::vector<IdDense> idsFilms);
+
+    // Getters
+    std::size_t getTaille() const;
+    bool estVide() const;
+    LigneLog getLigneLog(std::size_t index) const;
+    std::pair<std::size_t, std::size_t> getPlage(Timestamp debut, Timestamp fin) const;
+
+    // Colonnes
+    const std::vector<Timestamp>& getTimestamps() const;
+    const std::vector<IdDense>& getIdsUtilisateurs() const;
+    const std::vector<IdDense>& getIdsFilms() const;
+
+private:
+    std::vector<Timestamp> timestamps_;
+    std::vector<IdDense> idsUtilisateurs_;
+    std::vector<IdDense> idsFilms_;
+};
+
+#endif // JOURNALLOGS_H
@@ -0,0 +1,172 @@
+/// Lecture sans copie des lignes et des champs d'un fichier texte.
+/// \date 2026-10-17
+
+#ifndef LECTEURCHAMPS_H
+#define LECTEURCHAMPS_H
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+/// Classe qui découpe un texte en lignes (comme std::getline) sans copier les caractères.
+class LecteurLignes
+{
+public:
+    /// Constructeur qui initialise le texte à découper.
+    /// \param texte    Le texte à découper, qui doit rester valide pendant la lecture.
+    explicit LecteurLignes(std::string_view texte)
+        : reste_(texte)
+    {
+    }
+
+    /// Lit la prochaine ligne, sans le caractère de fin de ligne.
+    /// \param ligne    Reçoit une vue sur la ligne lue.
+    /// \return         True si une ligne a été lue, false à la fin du texte.
+    bool lireLigne(std::string_view& ligne)
+    {
+        if (reste_.empty())
+        {
+            return false;
+        }
+        std::size_t finLigne = reste_.find('\n');
+        if (finLigne == std::string_view::npos)
+        {
+            ligne = reste_;
+            reste_ = std::string_view();
+        }
+        else
+        {
+            ligne = reste_.substr(0, finLigne);
+            reste_.remove_prefix(finLigne + 1);
+        }
+        return true;
+    }
+
+private:
+    std::string_view reste_;
+};
+
+/// Classe qui lit les champs d'une ligne séparés par des espaces, avec les mêmes règles que l'opérateur >> de
+/// std::istream et std::quoted, mais en retournant des vues sur la ligne plutôt que des copies.
+class LecteurChamps
+{
+public:
+    /// Constructeur qui initialise la ligne à lire.
+    /// \param ligne    La ligne à lire, qui doit rester valide pendant la lecture.
+    explicit LecteurChamps(std::string_view ligne)
+        : reste_(ligne)
+    {
+    }
+
+    /// Lit un mot délimité par des espaces.
+    /// \param mot  Reçoit une vue sur le mot lu.
+    /// \return     True si un mot a été lu, false s'il n'y avait plus de champ.
+    bool lireMot(std::string_view& mot)
+    {
+        sauterEspaces();
+        std::size_t longueur = 0;
+        while (longueur < reste_.size() && !estEspace(reste_[longueur]))
+        {
+            longueur++;
+        }
+        if (longueur == 0)
+        {
+            return false;
+        }
+        mot = reste_.substr(0, longueur);
+        reste_.remove_prefix(longueur);
+        return true;
+    }
+
+    /// Lit une chaîne entre guillemets (avec \ comme caractère d'échappement) ou, à défaut, un mot.
+    /// \param chaine   Reçoit une vue sur la chaîne lue, sans les guillemets.
+    /// \param tampon   Tampon utilisé seulement si la chaîne contient des échappements, auquel cas la vue y réfère.
+    /// \return         True si une chaîne a été lue, false si le champ était absent ou le guillemet non fermé.
+    bool lireChaine(std::string_view& chaine, std::string& tampon)
+    {
+        sauterEspaces();
+        if (reste_.empty() || reste_.front() != '"')
+        {
+            return lireMot(chaine);
+        }
+
+        std::size_t position = 1;
+        while (position < reste_.size() && reste_[position] != '"' && reste_[position] != '\\')
+        {
+            position++;
+        }
+        if (position < reste_.size() && reste_[position] == '"')
+        {
+            chaine = reste_.substr(1, position - 1);
+            reste_.remove_prefix(position + 1);
+            return true;
+        }
+
+        // Chemin lent: la chaîne contient des échappements
+        tampon.assign(reste_.substr(1, position - 1));
+        while (position < reste_.size())
+        {
+            char caractere = reste_[position++];
+            if (caractere == '"')
+            {
+                chaine = tampon;
+                reste_.remove_prefix(position);
+                return true;
+            }
+            if (caractere == '\\')
+            {
+                if (position == reste_.size())
+                {
+                    break;
+                }
+                caractere = reste_[position++];
+            }
+            tampon.push_back(caractere);
+        }
+        return false;
+    }
+
+    /// Lit un entier en base 10.
+    /// \param valeur   Reçoit l'entier lu.
+    /// \return         True si un entier représentable a été lu, false sinon.
+    bool lireEntier(int& valeur)
+    {
+        sauterEspaces();
+        if (!reste_.empty() && reste_.front() == '+')
+        {
+            reste_.remove_prefix(1);
+        }
+        auto [fin, erreur] = std::from_chars(reste_.data(), reste_.data() + reste_.size(), valeur);
+        if (erreur != std::errc())
+        {
+            return false;
+        }
+        reste_.remove_prefix(static_cast<std::size_t>(fin - reste_.data()));
+        return true;
+    }
+
+private:
+    /// Indique si un caractère est un espace selon la locale "C".
+    /// \param caractere    Le caractère à tester.
+    /// \return             True si le caractère est un espace, false sinon.
+    static bool estEspace(char caractere)
+    {
+        return caractere == ' ' || (caractere >= '\t' && caractere <= '\r');
+    }
+
+    /// Avance jusqu'au prochain caractère qui n'est pas un espace.
+    void sauterEspaces()
+    {
+        std::size_t position = 0;
+        while (position < reste_.size() && estEspace(reste_[position]))
+        {
+            position++;
+        }
+        reste_.remove_prefix(position);
+    }
+
+    std::string_view reste_;
+};
+
+#endif // LECTEURCHAMPS_H
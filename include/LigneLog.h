@@ -5,16 +5,27 @@
 #ifndef LIGNELOG_H
 #define LIGNELOG_H
 
+#include <cstdint>
+#include <iostream>
+#include <optional>
 #include <string>
-#include "Film.h"
-#include "Utilisateur.h"
+#include <string_view>
+#include "IdDense.h"
 
-/// Struct contenant les informations traduites d'une ligne du log.
+/// Moment d'une entrée du log, en secondes depuis 1970-01-01T00:00:00Z (temps Unix).
+using Timestamp = std::int64_t;
+
+/// Struct contenant les informations traduites d'une ligne du log. L'utilisateur et le film sont désignés par les
+/// identifiants denses que leur ont attribués GestionnaireUtilisateurs et GestionnaireFilms.
 struct LigneLog
 {
-    std::string timestamp;
-    const Utilisateur* utilisateur;
-    const Film* film;
+    Timestamp timestamp;
+    IdDense idUtilisateur;
+    IdDense idFilm;
 };
 
+std::optional<Timestamp> convertirTimestamp(std::string_view texte);
+std::string getTimestampString(Timestamp timestamp);
+std::ostream& operator<<(std::ostream& outputStream, const LigneLog& ligneLog);
+
 #endif // LIGNELOG_H
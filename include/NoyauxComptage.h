@@ -0,0 +1,30 @@
+/// Noyaux vectoriels de comptage sur des colonnes d'identifiants denses.
+/// \date 2026-10-17
+
+#ifndef NOYAUXCOMPTAGE_H
+#define NOYAUXCOMPTAGE_H
+
+#include <cstddef>
+#include <vector>
+#include "IdDense.h"
+
+namespace NoyauxComptage
+{
+    /// Jeux d'instructions pouvant exécuter les noyaux, du plus lent au plus rapide.
+    enum class Implementation
+    {
+        Scalaire,
+        Sse2,
+        Avx2,
+    };
+
+    Implementation getMeilleureImplementation();
+    bool estSupportee(Implementation implementation);
+    const char* getNomImplementation(Implementation implementation);
+
+    std::size_t compterEgaux(const IdDense* cles, std::size_t nombreCles, IdDense cle);
+    std::size_t compterEgaux(const IdDense* cles, std::size_t nombreCles, IdDense cle, Implementation implementation);
+    void accumulerHistogramme(const IdDense* cles, std::size_t nombreCles, std::vector<int>& compteurs);
+} // namespace NoyauxComptage
+
+#endif // NOYAUXCOMPTAGE_H
@@ -5,7 +5,10 @@
 #ifndef PAYS_H
 #define PAYS_H
 
-#include <string>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
 
 /// Enum pour les différents pays.
 enum class Pays
@@ -21,6 +24,49 @@ enum class Pays
     Mexique
 };
 
-std::string getPaysString(Pays pays);
+/// Noms des pays, indexés par la valeur de l'enum.
+constexpr std::array<std::string_view, 9> nomsPays = {"Brésil",
+                                                      "Canada",
+                                                      "Chine",
+                                                      "États-Unis",
+                                                      "France",
+                                                      "Japon",
+                                                      "Royaume-Uni",
+                                                      "Russie",
+                                                      "Mexique"};
+constexpr std::size_t nombrePays = nomsPays.size();
+static_assert(static_cast<std::size_t>(Pays::Mexique) + 1 == nombrePays, "Un pays n'a pas de nom dans nomsPays");
+
+/// Indique si une valeur du enum Pays est l'un des pays nommés, par exemple après la conversion d'un entier.
+/// \param pays Le pays à vérifier.
+/// \return     True si le pays a un nom dans nomsPays, false sinon.
+constexpr bool estPaysValide(Pays pays)
+{
+    return static_cast<std::size_t>(pays) < nombrePays;
+}
+
+/// Convertit la valeur du enum Pays en string.
+/// \param pays Le pays à convertir.
+/// \return     String représentant le enum, qui pointe dans une table statique.
+constexpr std::string_view getPaysString(Pays pays)
+{
+    auto index = static_cast<std::size_t>(pays);
+    return index < nombrePays ? nomsPays[index] : "Erreur";
+}
+
+/// Trouve le pays qui correspond à un nom.
+/// \param nom  Le nom du pays, tel que retourné par getPaysString.
+/// \return     Le pays, ou std::nullopt si aucun pays n'a ce nom.
+constexpr std::optional<Pays> getPaysDepuisString(std::string_view nom)
+{
+    for (std::size_t index = 0; index < nombrePays; index++)
+    {
+        if (nomsPays[index] == nom)
+        {
+            return static_cast<Pays>(index);
+        }
+    }
+    return std::nullopt;
+}
 
 #endif // PAYS_H
@@ -0,0 +1,34 @@
+/// Table de chaînes de caractères internées.
+/// \date 2026-10-17
+
+#ifndef POOLCHAINES_H
+#define POOLCHAINES_H
+
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include "ArenaChaines.h"
+
+/// Classe qui conserve une seule copie de chaque chaîne distincte qu'on lui donne, dans son arène. Deux chaînes égales
+/// internées dans la même table partagent les mêmes caractères, qui restent valides tant qu'une des chaînes retournées
+/// existe, même après la destruction de la table. La table garde elle-même chaque chaîne distincte jusqu'à sa
+/// destruction: elle convient aux chaînes qui se répètent, pas à celles qui ne servent qu'une fois. Une table peut être
+/// partagée par plusieurs gestionnaires modifiés par des threads différents.
+class PoolChaines
+{
+public:
+    PoolChaines() = default;
+    PoolChaines(const PoolChaines&) = delete;
+    PoolChaines& operator=(const PoolChaines&) = delete;
+
+    ChaineArena interner(std::string_view chaine);
+    std::size_t getNombreChaines() const;
+
+private:
+    mutable std::mutex mutex_;
+    ArenaChaines arene_;
+    std::unordered_map<std::string_view, ChaineArena> chaines_; // Les clés pointent dans les chaînes de l'arène
+};
+
+#endif // POOLCHAINES_H
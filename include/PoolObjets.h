@@ -0,0 +1,182 @@
+/// Pool d'objets alloués par blocs.
+/// \date 2026-10-17
+
+#ifndef POOLOBJETS_H
+#define POOLOBJETS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Pool qui construit des objets dans des blocs de mémoire plutôt qu'avec une allocation chacun. Le premier bloc n'est
+/// alloué qu'à la première création, et chaque bloc a le double de la taille du précédent jusqu'à une taille maximale,
+/// pour qu'un petit pool n'occupe que peu de mémoire. L'adresse d'un objet ne change jamais tant qu'il n'est pas
+/// libéré, et l'emplacement d'un objet libéré est réutilisé par le prochain objet créé. Les blocs ne sont rendus qu'à
+/// la destruction du pool ou par vider(), qui détruisent aussi les objets qui n'ont pas été libérés.
+/// \tparam T   Le type des objets.
+template<typename T>
+class PoolObjets
+{
+public:
+    /// Constructeur.
+    /// \param objetsParBloc        Le nombre maximal d'objets que peut contenir un bloc.
+    /// \param objetsPremierBloc    Le nombre d'objets que peut contenir le premier bloc.
+    explicit PoolObjets(std::size_t objetsParBloc = 256, std::size_t objetsPremierBloc = 8)
+        : objetsParBloc_(std::max<std::size_t>(objetsParBloc, 1))
+        , objetsPremierBloc_(std::clamp<std::size_t>(objetsPremierBloc, 1, objetsParBloc_))
+    {
+    }
+
+    PoolObjets(const PoolObjets&) = delete;
+    PoolObjets& operator=(const PoolObjets&) = delete;
+
+    PoolObjets(PoolObjets&& other) noexcept
+        : blocs_(std::move(other.blocs_))
+        , libres_(std::move(other.libres_))
+        , objetsParBloc_(other.objetsParBloc_)
+        , objetsPremierBloc_(other.objetsPremierBloc_)
+    {
+        other.blocs_.clear();
+        other.libres_.clear();
+    }
+
+    PoolObjets& operator=(PoolObjets&& other) noexcept
+    {
+        if (this != &other)
+        {
+            vider();
+            std::swap(blocs_, other.blocs_);
+            std::swap(libres_, other.libres_);
+            std::swap(objetsParBloc_, other.objetsParBloc_);
+            std::swap(objetsPremierBloc_, other.objetsPremierBloc_);
+        }
+        return *this;
+    }
+
+    ~PoolObjets()
+    {
+        vider();
+    }
+
+    /// Construit une copie d'un objet dans le pool.
+    /// \param valeur   L'objet à copier.
+    /// \return         Un pointeur stable vers la copie.
+    T* creer(const T& valeur)
+    {
+        void* emplacement;
+        if (!libres_.empty())
+        {
+            emplacement = libres_.back();
+            libres_.pop_back();
+        }
+        else
+        {
+            if (blocs_.empty() || blocs_.back().nombreUtilises == blocs_.back().capacite)
+            {
+                std::size_t capacite =
+                    blocs_.empty() ? objetsPremierBloc_ : std::min(blocs_.back().capacite * 2, objetsParBloc_);
+                blocs_.push_back(Bloc{std::make_unique<Emplacement[]>(capacite), capacite, 0});
+            }
+            Bloc& bloc = blocs_.back();
+            emplacement = &bloc.emplacements[bloc.nombreUtilises++];
+        }
+        return new (emplacement) T(valeur);
+    }
+
+    /// Détruit un objet et rend son emplacement au pool. Le pointeur ne doit plus être utilisé.
+    /// \param objet    Un objet créé par ce pool.
+    void liberer(T* objet)
+    {
+        objet->~T();
+        libres_.push_back(objet);
+    }
+
+    /// Prend les blocs et les objets d'un autre pool, sans déplacer les objets: leurs adresses restent valides et ils
+    /// seront libérés et détruits par ce pool. Les emplacements jamais utilisés des blocs pris deviennent libres.
+    /// \param other    Le pool dont les blocs sont pris, vide ensuite.
+    void absorber(PoolObjets&& other)
+    {
+        for (Bloc& bloc : other.blocs_)
+        {
+            for (std::size_t i = bloc.nombreUtilises; i < bloc.capacite; i++)
+            {
+                libres_.push_back(reinterpret_cast<T*>(&bloc.emplacements[i]));
+            }
+            bloc.nombreUtilises = bloc.capacite;
+        }
+        // Les blocs pris sont placés avant le dernier bloc, qui reste celui où les objets sont créés
+        blocs_.insert(blocs_.begin(), std::make_move_iterator(other.blocs_.begin()),
+                      std::make_move_iterator(other.blocs_.end()));
+        libres_.insert(libres_.end(), other.libres_.begin(), other.libres_.end());
+        other.blocs_.clear();
+        other.libres_.clear();
+    }
+
+    /// Indique si un objet est dans un bloc du pool, en O(nombre de blocs).
+    /// \param objet    Un objet.
+    /// \return         True si l'objet a été créé par ce pool ou par un pool qu'il a absorbé, false sinon.
+    bool contient(const T* objet) const
+    {
+        return std::any_of(blocs_.begin(), blocs_.end(), [objet](const Bloc& bloc) {
+            const T* debut = reinterpret_cast<const T*>(bloc.emplacements.get());
+            return !std::less<const T*>()(objet, debut) && std::less<const T*>()(objet, debut + bloc.capacite);
+        });
+    }
+
+    /// Détruit les objets qui n'ont pas été libérés et rend tous les blocs, ce qui invalide tous les objets du pool.
+    void vider()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            // Les emplacements libérés ont déjà été détruits: ils sont triés pour être sautés
+            std::sort(libres_.begin(), libres_.end(), std::less<T*>());
+            for (Bloc& bloc : blocs_)
+            {
+                for (std::size_t i = 0; i < bloc.nombreUtilises; i++)
+                {
+                    T* objet = reinterpret_cast<T*>(&bloc.emplacements[i]);
+                    if (!std::binary_search(libres_.begin(), libres_.end(), objet, std::less<T*>()))
+                    {
+                        std::launder(objet)->~T();
+                    }
+                }
+            }
+        }
+        blocs_.clear();
+        libres_.clear();
+    }
+
+    /// Retourne le nombre de blocs alloués.
+    /// \return Le nombre de blocs.
+    std::size_t getNombreBlocs() const
+    {
+        return blocs_.size();
+    }
+
+private:
+    /// Mémoire non initialisée de la taille et de l'alignement d'un objet.
+    struct alignas(T) Emplacement
+    {
+        unsigned char octets[sizeof(T)];
+    };
+
+    /// Bloc d'emplacements, dont les premiers ont été utilisés.
+    struct Bloc
+    {
+        std::unique_ptr<Emplacement[]> emplacements;
+        std::size_t capacite;
+        std::size_t nombreUtilises;
+    };
+
+    std::vector<Bloc> blocs_;
+    std::vector<T*> libres_;
+    std::size_t objetsParBloc_;
+    std::size_t objetsPremierBloc_;
+};
+
+#endif // POOLOBJETS_H
@@ -0,0 +1,185 @@
+/// Publication d'objets immuables à des threads lecteurs.
+/// \date 2026-10-17
+
+#ifndef PUBLICATIONEPOQUES_H
+#define PUBLICATIONEPOQUES_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// Classe qui publie des versions successives d'un objet immuable à des threads lecteurs, à la manière de RCU: un seul
+/// thread écrivain remplace l'objet publié par un pointeur atomique, et les lecteurs lisent la version publiée sans
+/// verrou ni boucle d'attente (quatre opérations atomiques par lecture). Chaque lecteur annonce l'époque à laquelle il
+/// a commencé sa lecture dans un emplacement qui lui est réservé; une version remplacée n'est détruite par l'écrivain
+/// qu'une fois qu'aucun lecteur ne lit depuis une époque où elle pouvait encore être publiée.
+/// \tparam T   Le type de l'objet publié, constructible par défaut pour la version initiale.
+template<typename T>
+class PublicationEpoques
+{
+public:
+    /// Nombre maximal de lecteurs existant en même temps.
+    static constexpr std::size_t nombreMaximalLecteurs = 64;
+
+    /// Accès d'un thread lecteur aux versions publiées. Un lecteur ne doit être utilisé que par un thread à la fois et
+    /// doit être détruit avant la publication.
+    class Lecteur
+    {
+    public:
+        /// Constructeur qui réserve un emplacement de lecteur.
+        /// \param publication  La publication à lire.
+        explicit Lecteur(PublicationEpoques& publication)
+            : publication_(&publication)
+        {
+            for (std::size_t i = 0; i < nombreMaximalLecteurs; i++)
+            {
+                bool estOccupe = false;
+                if (publication.emplacements_[i].estOccupe.compare_exchange_strong(estOccupe, true))
+                {
+                    index_ = i;
+                    return;
+                }
+            }
+        }
+
+        Lecteur(const Lecteur&) = delete;
+        Lecteur& operator=(const Lecteur&) = delete;
+
+        Lecteur(Lecteur&& other) noexcept
+            : publication_(other.publication_)
+            , index_(std::exchange(other.index_, indexInvalide))
+        {
+        }
+
+        Lecteur& operator=(Lecteur&&) = delete;
+
+        ~Lecteur()
+        {
+            if (estValide())
+            {
+                publication_->emplacements_[index_].estOccupe.store(false);
+            }
+        }
+
+        /// Indique si un emplacement a pu être réservé pour ce lecteur.
+        /// \return     False si nombreMaximalLecteurs lecteurs existaient déjà, true sinon.
+        bool estValide() const
+        {
+            return index_ != indexInvalide;
+        }
+
+        /// Appelle une fonction sur la version publiée. La version ne peut pas être détruite pendant l'appel, mais une
+        /// version plus récente peut être publiée entre deux appels.
+        /// \param fonction     La fonction, qui reçoit une référence constante vers la version et dont la référence ne
+        ///                     doit pas être gardée après l'appel. Le lecteur doit être valide.
+        /// \return             Le résultat de la fonction.
+        template<typename Fonction>
+        auto lire(Fonction fonction) const
+        {
+            std::atomic<std::uint64_t>& epoqueLecteur = publication_->emplacements_[index_].epoque;
+            epoqueLecteur.store(publication_->epoque_.load());
+            const T* version = publication_->courant_.load();
+            auto resultat = fonction(*version);
+            epoqueLecteur.store(0);
+            return resultat;
+        }
+
+    private:
+        static constexpr std::size_t indexInvalide = std::numeric_limits<std::size_t>::max();
+
+        PublicationEpoques* publication_;
+        std::size_t index_ = indexInvalide;
+    };
+
+    /// Constructeur qui publie une version construite par défaut.
+    PublicationEpoques()
+        : courant_(new T())
+    {
+    }
+
+    PublicationEpoques(const PublicationEpoques&) = delete;
+    PublicationEpoques& operator=(const PublicationEpoques&) = delete;
+
+    /// Destructeur. Aucun lecteur ne doit exister.
+    ~PublicationEpoques()
+    {
+        for (const auto& [epoque, version] : retirees_)
+        {
+            delete version;
+        }
+        delete courant_.load();
+    }
+
+    /// Remplace la version publiée, puis détruit les versions remplacées que plus aucun lecteur ne peut lire. Ne doit
+    /// être appelée que par le thread écrivain.
+    /// \param version  La nouvelle version.
+    void publier(std::unique_ptr<const T> version)
+    {
+        const T* ancienne = courant_.exchange(version.release());
+        retirees_.emplace_back(epoque_.fetch_add(1), ancienne);
+        recupererVersions();
+    }
+
+    /// Retourne la version publiée, pour le thread écrivain seulement: seul l'écrivain peut la détruire.
+    /// \return     La version publiée.
+    const T& getVersionPubliee() const
+    {
+        return *courant_.load();
+    }
+
+    /// Retourne le nombre de versions remplacées qui attendent la fin d'une lecture pour être détruites.
+    /// \return     Le nombre de versions retirées.
+    std::size_t getNombreVersionsRetirees() const
+    {
+        return retirees_.size();
+    }
+
+private:
+    /// Emplacement d'un lecteur, seul sur sa ligne de cache pour que les lecteurs ne se ralentissent pas entre eux.
+    struct alignas(64) Emplacement
+    {
+        std::atomic<std::uint64_t> epoque{0}; // 0 en dehors d'une lecture
+        std::atomic<bool> estOccupe{false};
+    };
+
+    /// Détruit les versions retirées avant l'époque de la plus ancienne lecture en cours. Un lecteur qui a commencé à
+    /// l'époque e a lu le pointeur après la publication qui a fait passer l'époque à e, donc ne peut pas lire une
+    /// version retirée à une époque inférieure à e.
+    void recupererVersions()
+    {
+        std::uint64_t epoqueMinimale = std::numeric_limits<std::uint64_t>::max();
+        for (const Emplacement& emplacement : emplacements_)
+        {
+            std::uint64_t epoque = emplacement.epoque.load();
+            if (epoque != 0 && epoque < epoqueMinimale)
+            {
+                epoqueMinimale = epoque;
+            }
+        }
+        auto finRecuperees = retirees_.begin();
+        for (auto it = retirees_.begin(); it != retirees_.end(); ++it)
+        {
+            if (it->first < epoqueMinimale)
+            {
+                delete it->second;
+            }
+            else
+            {
+                *finRecuperees++ = *it;
+            }
+        }
+        retirees_.erase(finRecuperees, retirees_.end());
+    }
+
+    std::atomic<const T*> courant_;
+    std::atomic<std::uint64_t> epoque_{1};
+    std::array<Emplacement, nombreMaximalLecteurs> emplacements_;
+    std::vector<std::pair<std::uint64_t, const T*>> retirees_; // Époque du retrait et version, pour l'écrivain seul
+};
+
+#endif // PUBLICATIONEPOQUES_H
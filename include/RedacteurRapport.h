@@ -0,0 +1,56 @@
+/// Rédacteur de rapports sur les films et les utilisateurs.
+/// \date 2026-10-17
+
+#ifndef REDACTEURRAPPORT_H
+#define REDACTEURRAPPORT_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include "Film.h"
+#include "Utilisateur.h"
+
+class GestionnaireFilms;
+class GestionnaireUtilisateurs;
+
+/// Classe qui formate des rapports dans un grand tampon réutilisé plutôt que champ par champ dans un stream. Le tampon
+/// est remis au stream de sortie en un seul appel à write() chaque fois qu'il est plein, puis à vider() ou à la
+/// destruction du rédacteur. Pour qu'un tampon plein ne coûte qu'un appel système, la sortie peut être un fichier sans
+/// tampon propre (voir std::basic_streambuf::pubsetbuf).
+class RedacteurRapport
+{
+public:
+    /// Formats de rapport. Le texte est identique à celui des opérateurs << des gestionnaires.
+    enum class Format
+    {
+        Texte,
+        Csv,
+        Json
+    };
+
+    RedacteurRapport(std::ostream& sortie, Format format, std::size_t tailleTampon = 64 * 1024);
+    RedacteurRapport(const RedacteurRapport&) = delete;
+    RedacteurRapport& operator=(const RedacteurRapport&) = delete;
+    ~RedacteurRapport();
+
+    void ecrireFilms(const GestionnaireFilms& gestionnaireFilms);
+    void ecrireUtilisateurs(const GestionnaireUtilisateurs& gestionnaireUtilisateurs);
+    void vider();
+
+private:
+    void ecrireFilm(const Film& film, bool estPremier);
+    void ecrireUtilisateur(const Utilisateur& utilisateur, bool estPremier);
+    void ajouter(std::string_view texte);
+    void ajouterEntier(long long valeur);
+    void ajouterChaineCsv(std::string_view texte);
+    void ajouterChaineJson(std::string_view texte);
+    void viderSiPlein();
+
+    std::ostream& sortie_;
+    Format format_;
+    std::size_t tailleTampon_;
+    std::string tampon_;
+};
+
+#endif // REDACTEURRAPPORT_H
@@ -0,0 +1,24 @@
+/// Requête composée sur les films.
+/// \date 2026-10-17
+
+#ifndef REQUETEFILMS_H
+#define REQUETEFILMS_H
+
+#include <optional>
+#include <string_view>
+#include "Film.h"
+
+/// Struct contenant une conjonction de critères sur les films. Un critère vide ne filtre rien, donc une requête vide
+/// accepte tous les films. Les bornes d'années sont incluses.
+struct RequeteFilms
+{
+    std::optional<Film::Genre> genre;
+    std::optional<Pays> pays;
+    std::optional<int> anneeDebut;
+    std::optional<int> anneeFin;
+    std::optional<std::string_view> realisateur;
+
+    bool estSatisfaitePar(const Film& film) const;
+};
+
+#endif // REQUETEFILMS_H
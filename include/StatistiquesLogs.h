@@ -0,0 +1,47 @@
+/// Statistiques des logs publiées aux threads lecteurs.
+/// \date 2026-10-17
+
+#ifndef STATISTIQUESLOGS_H
+#define STATISTIQUESLOGS_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Film.h"
+#include "IdDense.h"
+#include "JournalLogs.h"
+#include "LigneLog.h"
+#include "Tests.h"
+#include "Utilisateur.h"
+
+/// Classe contenant une version immuable des statistiques d'un AnalyseurLogs, publiée par l'analyseur pour que des
+/// threads lecteurs l'interrogent pendant qu'il continue à recevoir des logs (voir AnalyseurLogs::activerPublication).
+/// Les lignes de log sont gardées en segments triés partagés d'une version à l'autre: une nouvelle version ne copie
+/// que les compteurs et les lignes reçues depuis la précédente.
+class StatistiquesLogs
+{
+public:
+    // Statistiques
+    std::size_t getNombreLignes() const;
+    int getNombreVuesFilm(const Film* film) const;
+    const Film* getFilmPlusPopulaire() const;
+    std::vector<std::pair<const Film*, int>> getNFilmsPlusPopulaires(std::size_t nombre) const;
+    int getNombreVuesPourUtilisateur(const Utilisateur* utilisateur) const;
+    int getNombreVuesFilmEntre(const Film* film, Timestamp debut, Timestamp fin) const;
+
+private:
+    IdDense getIdFilm(const Film* film) const;
+
+    std::vector<const Film*> films_;                         // Identifiant dense -> film
+    std::vector<const Utilisateur*> utilisateurs_;           // Identifiant dense -> utilisateur
+    std::vector<int> vuesFilms_;                             // Indexé par identifiant dense de film
+    std::vector<int> vuesUtilisateurs_;                      // Indexé par identifiant dense d'utilisateur
+    std::vector<std::pair<IdDense, int>> classement_;        // En ordre décroissant de vues
+    std::vector<std::shared_ptr<const JournalLogs>> segments_; // Chacun trié, du plus grand au plus petit
+
+    friend class AnalyseurLogs;
+    friend double Tests::testAnalyseurLogs(); // Pour les tests
+};
+
+#endif // STATISTIQUESLOGS_H
@@ -6,16 +6,18 @@
 #define UTILISATEUR_H
 
 #include <iostream>
-#include <string>
+#include "ArenaChaines.h"
+#include "IdDense.h"
 #include "Pays.h"
 
 /// Struct contenant les informations pour un utilisateur.
 struct Utilisateur
 {
-    std::string id;
-    std::string nom;
+    ChaineArena id; // Interné par le gestionnaire à l'ajout, comme le nom
+    ChaineArena nom;
     int age;
     Pays pays;
+    IdDense idDense = idDenseInvalide; // Attribué par GestionnaireUtilisateurs
 };
 
 std::ostream& operator<<(std::ostream& outputStream, const Utilisateur& utilisateur);
@@ -0,0 +1,128 @@
+/// Vue sur une suite de films.
+/// \date 2026-10-17
+
+#ifndef VUEFILMS_H
+#define VUEFILMS_H
+
+#include <cstddef>
+#include <iterator>
+#include "Film.h"
+
+/// Vue non possédante sur une suite contiguë de pointeurs de films, comme un std::span (C++20). Les emplacements nuls,
+/// laissés par les films retirés d'une catégorie qui n'a pas encore été compactée, sont sautés par le parcours. La vue
+/// ne copie rien et n'est valide que jusqu'à la prochaine modification du gestionnaire qui l'a retournée.
+class VueFilms
+{
+public:
+    /// Itérateur sur les films non nuls de la vue.
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = const Film*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Film* const*;
+        using reference = const Film* const&;
+
+        const_iterator() = default;
+
+        /// Constructeur.
+        /// \param position Pointeur vers l'emplacement de départ.
+        /// \param fin      Pointeur après le dernier emplacement de la vue.
+        const_iterator(const Film* const* position, const Film* const* fin)
+            : position_(position)
+            , fin_(fin)
+        {
+            sauterEmplacementsNuls();
+        }
+
+        reference operator*() const
+        {
+            return *position_;
+        }
+
+        const_iterator& operator++()
+        {
+            ++position_;
+            sauterEmplacementsNuls();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator copie = *this;
+            ++*this;
+            return copie;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return position_ == other.position_;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return position_ != other.position_;
+        }
+
+    private:
+        void sauterEmplacementsNuls()
+        {
+            while (position_ != fin_ && *position_ == nullptr)
+            {
+                ++position_;
+            }
+        }
+
+        const Film* const* position_ = nullptr;
+        const Film* const* fin_ = nullptr;
+    };
+
+    VueFilms() = default;
+
+    /// Constructeur pour une suite sans emplacement nul.
+    /// \param debut    Pointeur vers le premier film de la vue.
+    /// \param fin      Pointeur après le dernier film de la vue.
+    VueFilms(const Film* const* debut, const Film* const* fin)
+        : VueFilms(debut, fin, static_cast<std::size_t>(fin - debut))
+    {
+    }
+
+    /// Constructeur pour une suite qui peut contenir des emplacements nuls.
+    /// \param debut            Pointeur vers le premier emplacement de la vue.
+    /// \param fin              Pointeur après le dernier emplacement de la vue.
+    /// \param nombreFilms      Le nombre d'emplacements non nuls entre debut et fin.
+    VueFilms(const Film* const* debut, const Film* const* fin, std::size_t nombreFilms)
+        : debut_(debut)
+        , fin_(fin)
+        , nombreFilms_(nombreFilms)
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(debut_, fin_);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(fin_, fin_);
+    }
+
+    std::size_t size() const
+    {
+        return nombreFilms_;
+    }
+
+    bool empty() const
+    {
+        return nombreFilms_ == 0;
+    }
+
+private:
+    const Film* const* debut_ = nullptr;
+    const Film* const* fin_ = nullptr;
+    std::size_t nombreFilms_ = 0;
+};
+
+#endif // VUEFILMS_H
@@ -7,13 +7,212 @@
 #include "AnalyseurLogs.h"
 #include <algorithm>
 #include <fstream>
-#include <iomanip>
+#include <functional>
 #include <iostream>
-#include <sstream>
-#include <unordered_set>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <thread>
+#include "FichierMappe.h"
 #include "Foncteurs.h"
+#include "Instantane.h"
+#include "LecteurChamps.h"
+#include "NoyauxComptage.h"
+
+namespace
+{
+    /// Taille minimale d'un morceau de fichier, en octets, pour qu'il vaille la peine de démarrer un thread.
+    constexpr std::size_t tailleMinimaleMorceau = 64 * 1024;
+
+    /// Nombre de lignes en retard accumulées avant de les fusionner au journal en un seul passage.
+    constexpr std::size_t tailleLotLignesEnRetard = 1024;
+
+    /// Nombre de lignes gardées par un producteur avant de les transmettre à l'analyseur en un seul lot.
+    constexpr std::size_t tailleLotProducteur = 4096;
+
+    /// Fusionne le dernier segment publié avec celui qui le précède tant qu'il en a au moins la moitié de la taille.
+    /// Les segments précédents ne sont pas modifiés puisque des lecteurs peuvent les lire: la fusion en est une copie.
+    /// \param segments         Les segments publiés, triés chacun, du plus ancien au plus récent.
+    void fusionnerSegments(std::vector<std::shared_ptr<const JournalLogs>>& segments)
+    {
+        while (segments.size() >= 2 && segments.back()->getTaille() * 2 >= segments[segments.size() - 2]->getTaille())
+        {
+            const JournalLogs& dernier = *segments.back();
+            std::vector<LigneLog> lignesLog;
+            lignesLog.reserve(dernier.getTaille());
+            for (std::size_t i = 0; i < dernier.getTaille(); i++)
+            {
+                lignesLog.push_back(dernier.getLigneLog(i));
+            }
+            auto fusion = std::make_shared<JournalLogs>(*segments[segments.size() - 2]);
+            fusion->fusionner(std::move(lignesLog));
+            segments.pop_back();
+            segments.back() = std::move(fusion);
+        }
+    }
+
+    /// Struct contenant le résultat de l'interprétation d'un morceau du fichier de logs par un thread.
+    struct ResultatMorceau
+    {
+        std::vector<LigneLog> lignesLog;               // Triées en ordre chronologique
+        std::vector<VuesUtilisateur> vuesUtilisateurs; // Indexé par identifiant dense d'utilisateur
+        std::string messagesErreur;
+        bool succesParsing = true;
+    };
+
+    /// Découpe un texte en morceaux de tailles semblables se terminant tous par une fin de ligne (sauf le dernier).
+    /// \param texte            Le texte à découper.
+    /// \param nombreMorceaux   Le nombre de morceaux souhaité.
+    /// \return                 Les morceaux, dans l'ordre du texte. Il peut y en avoir moins que demandé.
+    std::vector<std::string_view> decouperEnMorceaux(std::string_view texte, std::size_t nombreMorceaux)
+    {
+        std::vector<std::string_view> morceaux;
+        std::size_t tailleCible = texte.size() / std::max<std::size_t>(nombreMorceaux, 1) + 1;
+        while (morceaux.size() + 1 < nombreMorceaux && texte.size() > tailleCible)
+        {
+            std::size_t finLigne = texte.find('\n', tailleCible);
+            if (finLigne == std::string_view::npos)
+            {
+                break;
+            }
+            morceaux.push_back(texte.substr(0, finLigne + 1));
+            texte.remove_prefix(finLigne + 1);
+        }
+        morceaux.push_back(texte);
+        return morceaux;
+    }
+
+    /// Interprète des lignes de logs et garde celles dont l'utilisateur et le film existent, dans l'ordre du texte. Les
+    /// gestionnaires ne sont que lus, ce qui permet d'appeler cette fonction à partir de plusieurs threads à la fois.
+    /// \param texte                    Les lignes à interpréter.
+    /// \param gestionnaireUtilisateurs Le gestionnaire des utilisateurs pour lier un utilisateur à un log.
+    /// \param gestionnaireFilms        Le gestionnaire des films pour lier un film à un log.
+    /// \param lignesLog                Reçoit les lignes interprétées.
+    /// \param messagesErreur           Reçoit un message pour chaque ligne qui n'a pas pu être interprétée.
+    /// \return                         True si toutes les lignes ont pu être interprétées, false sinon.
+    bool interpreterLignes(std::string_view texte,
+                           const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                           const GestionnaireFilms& gestionnaireFilms,
+                           std::vector<LigneLog>& lignesLog,
+                           std::string& messagesErreur)
+    {
+        // Tampon réutilisé d'une ligne à l'autre, seulement pour les noms de films contenant des échappements
+        std::string tamponNomFilm;
+
+        bool succesParsing = true;
+        LecteurLignes lecteurLignes(texte);
+        std::string_view ligne;
+        while (lecteurLignes.lireLigne(ligne))
+        {
+            LecteurChamps lecteurChamps(ligne);
+
+            std::string_view texteTimestamp;
+            std::optional<Timestamp> timestamp;
+            std::string_view vueIdUtilisateur;
+            std::string_view vueNomFilm;
+
+            if (lecteurChamps.lireMot(texteTimestamp) && (timestamp = convertirTimestamp(texteTimestamp)) &&
+                lecteurChamps.lireMot(vueIdUtilisateur) && lecteurChamps.lireChaine(vueNomFilm, tamponNomFilm))
+            {
+                const Utilisateur* utilisateur = gestionnaireUtilisateurs.getUtilisateurParId(vueIdUtilisateur);
+                const Film* film = gestionnaireFilms.getFilmParNom(vueNomFilm);
+                if (utilisateur != nullptr && film != nullptr)
+                {
+                    lignesLog.push_back(LigneLog{*timestamp, utilisateur->idDense, film->idDense});
+                }
+            }
+            else
+            {
+                messagesErreur.append("Erreur AnalyseurLogs: la ligne ")
+                    .append(ligne)
+                    .append(" n'a pas pu être interprétée correctement\n");
+                succesParsing = false;
+            }
+        }
+        return succesParsing;
+    }
+
+    /// Interprète les lignes d'un morceau du fichier de logs et compte les vues de chaque utilisateur du morceau.
+    /// \param morceau                  Le morceau du fichier à interpréter.
+    /// \param gestionnaireUtilisateurs Le gestionnaire des utilisateurs pour lier un utilisateur à un log.
+    /// \param gestionnaireFilms        Le gestionnaire des films pour lier un film à un log.
+    /// \param resultat                 Reçoit les lignes triées, les vues par utilisateur et les erreurs du morceau.
+    void interpreterMorceau(std::string_view morceau,
+                            const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                            const GestionnaireFilms& gestionnaireFilms,
+                            ResultatMorceau& resultat)
+    {
+        resultat.succesParsing = interpreterLignes(
+            morceau, gestionnaireUtilisateurs, gestionnaireFilms, resultat.lignesLog, resultat.messagesErreur);
+
+        resultat.vuesUtilisateurs.resize(gestionnaireUtilisateurs.getNombreIdsDenses());
+        for (const LigneLog& ligneLog : resultat.lignesLog)
+        {
+            VuesUtilisateur& vuesUtilisateur = resultat.vuesUtilisateurs[ligneLog.idUtilisateur];
+            vuesUtilisateur.nombreVues++;
+            vuesUtilisateur.filmsVus.insert(ligneLog.idFilm);
+        }
+
+        if (!std::is_sorted(resultat.lignesLog.begin(), resultat.lignesLog.end(), ComparateurLog()))
+        {
+            std::stable_sort(resultat.lignesLog.begin(), resultat.lignesLog.end(), ComparateurLog());
+        }
+    }
+
+    /// Fusionne les lignes triées de chaque morceau (fusion à k voies). À timestamp égal, les lignes du premier
+    /// morceau passent en premier, ce qui préserve l'ordre du fichier comme un tri stable du fichier complet.
+    /// \param resultats        Les résultats des morceaux, dans l'ordre du fichier.
+    /// \param nombreLignes     Le nombre total de lignes des morceaux.
+    /// \param logs             Le journal vide qui reçoit toutes les lignes en ordre chronologique.
+    void fusionnerMorceaux(std::vector<ResultatMorceau>& resultats, std::size_t nombreLignes, JournalLogs& logs)
+    {
+        logs.reserver(nombreLignes);
+        if (resultats.size() == 1)
+        {
+            for (const LigneLog& ligneLog : resultats[0].lignesLog)
+            {
+                logs.ajouterALaFin(ligneLog);
+            }
+            return;
+        }
+
+        std::vector<std::size_t> positions(resultats.size(), 0);
+        auto estApres = [&](std::size_t morceau1, std::size_t morceau2) {
+            const LigneLog& ligneLog1 = resultats[morceau1].lignesLog[positions[morceau1]];
+            const LigneLog& ligneLog2 = resultats[morceau2].lignesLog[positions[morceau2]];
+            if (ComparateurLog()(ligneLog2, ligneLog1))
+            {
+                return true;
+            }
+            return !ComparateurLog()(ligneLog1, ligneLog2) && morceau1 > morceau2;
+        };
+        std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(estApres)> tetes(estApres);
+        for (std::size_t i = 0; i < resultats.size(); i++)
+        {
+            if (!resultats[i].lignesLog.empty())
+            {
+                tetes.push(i);
+            }
+        }
+        while (!tetes.empty())
+        {
+            std::size_t morceau = tetes.top();
+            tetes.pop();
+            logs.ajouterALaFin(resultats[morceau].lignesLog[positions[morceau]]);
+            if (++positions[morceau] < resultats[morceau].lignesLog.size())
+            {
+                tetes.push(morceau);
+            }
+        }
+    }
+} // namespace
 
 /// Ajoute les lignes de log en ordre chronologique à partir d'un fichier de logs.
+/// Le fichier est découpé en morceaux aux fins de ligne et chaque morceau est interprété et trié par un thread
+/// différent (voir setNombreThreads). Les morceaux sont ensuite fusionnés; le résultat et les messages d'erreur sont
+/// identiques à ceux d'un chargement avec un seul thread. Les vues des films sont ensuite comptées en un seul passage
+/// sur la colonne des films.
 /// \param nomFichier               Le fichier à partir duquel lire les logs.
 /// \param gestionnaireUtilisateurs Référence au gestionnaire des utilisateurs pour lier un utilisateur à un log.
 /// \param gestionnaireFilms        Référence au gestionnaire des films pour pour lier un film à un log.
@@ -22,133 +221,1251 @@ bool AnalyseurLogs::chargerDepuisFichier(const std::string& nomFichier,
                                          GestionnaireUtilisateurs& gestionnaireUtilisateurs,
                                          GestionnaireFilms& gestionnaireFilms)
 {
-    std::ifstream fichier(nomFichier);
-    if (fichier)
+    FichierMappe fichier(nomFichier);
+    if (fichier.estOuvert())
     {
-        logs_.clear();
-        vuesFilms_.clear();
+        logs_.vider();
+        lignesEnAttente_.clear();
+        lignesEnRetard_.clear();
+        nombreLignesEnRetard_ = 0;
+        producteurs_.reinitialiser();
+        associerGestionnaires(gestionnaireUtilisateurs, gestionnaireFilms);
+        vuesFilms_.assign(films_.size(), 0);
+        vuesUtilisateurs_.assign(utilisateurs_.size(), VuesUtilisateur());
 
-        bool succesParsing = true;
+        unsigned int nombreThreads = getNombreThreads();
+        std::size_t nombreMorceauxMaximal = std::max<std::size_t>(
+            1, fichier.getContenu().size() / tailleMinimaleMorceau);
+        std::vector<std::string_view> morceaux =
+            decouperEnMorceaux(fichier.getContenu(), std::min<std::size_t>(nombreThreads, nombreMorceauxMaximal));
 
-        std::string ligne;
-        while (std::getline(fichier, ligne))
+        std::vector<ResultatMorceau> resultats(morceaux.size());
+        std::vector<std::thread> threads;
+        threads.reserve(morceaux.size() - 1);
+        for (std::size_t i = 1; i < morceaux.size(); i++)
         {
-            std::istringstream stream(ligne);
-
-            std::string timestamp;
-            std::string idUtilisateur;
-            std::string nomFilm;
+            threads.emplace_back(interpreterMorceau,
+                                 morceaux[i],
+                                 std::cref(gestionnaireUtilisateurs),
+                                 std::cref(gestionnaireFilms),
+                                 std::ref(resultats[i]));
+        }
+        interpreterMorceau(morceaux[0], gestionnaireUtilisateurs, gestionnaireFilms, resultats[0]);
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
 
-            if (stream >> timestamp >> idUtilisateur >> std::quoted(nomFilm))
-            {
-                // TODO: Uncomment une fois que la fonction creerLigneLog est écrite
-                 creerLigneLog(timestamp, idUtilisateur, nomFilm, gestionnaireUtilisateurs, gestionnaireFilms);
-            }
-            else
+        bool succesParsing = true;
+        std::size_t nombreLignes = 0;
+        for (const ResultatMorceau& resultat : resultats)
+        {
+            std::cerr << resultat.messagesErreur;
+            succesParsing = succesParsing && resultat.succesParsing;
+            nombreLignes += resultat.lignesLog.size();
+            for (std::size_t idUtilisateur = 0; idUtilisateur < vuesUtilisateurs_.size(); idUtilisateur++)
             {
-                std::cerr << "Erreur AnalyseurLogs: la ligne " << ligne
-                          << " n'a pas pu être interprétée correctement\n";
-                succesParsing = false;
+                const VuesUtilisateur& vuesMorceau = resultat.vuesUtilisateurs[idUtilisateur];
+                VuesUtilisateur& vuesUtilisateur = vuesUtilisateurs_[idUtilisateur];
+                vuesUtilisateur.nombreVues += vuesMorceau.nombreVues;
+                vuesUtilisateur.filmsVus.insert(vuesMorceau.filmsVus.begin(), vuesMorceau.filmsVus.end());
             }
         }
+        fusionnerMorceaux(resultats, nombreLignes, logs_);
+        NoyauxComptage::accumulerHistogramme(logs_.getIdsFilms().data(), logs_.getTaille(), vuesFilms_);
+        classementFilms_.reconstruire(vuesFilms_);
+        fichierSuivi_ = nomFichier;
+        positionSuivi_ = fichier.getContenu().size();
+        publication_.journalAPublier = true;
+        publierStatistiques();
         return succesParsing;
     }
     std::cerr << "Erreur AnalyseurLogs: le fichier " << nomFichier << " n'a pas pu être ouvert\n";
     return false;
 }
 
+/// Ajoute les lignes complètes écrites à la fin d'un fichier de logs depuis le dernier appel, pour suivre un fichier
+/// auquel un serveur ajoute des lignes en continu. Seuls les octets qui suivent la position retenue sont lus: le coût
+/// d'un appel est proportionnel aux nouvelles données et non à la taille du fichier. Une dernière ligne sans fin de
+/// ligne est laissée pour l'appel suivant, puisqu'elle est peut-être en cours d'écriture.
+/// Le suivi commence au début d'un fichier qui n'a pas encore été suivi, ou à la fin d'un fichier chargé par
+/// chargerDepuisFichier. Un fichier devenu plus court que la position retenue (tronqué ou remplacé par la rotation des
+/// logs) est repris depuis le début.
+/// \param nomFichier               Le fichier de logs à suivre.
+/// \param gestionnaireUtilisateurs Le gestionnaire des utilisateurs pour lier un utilisateur à un log.
+/// \param gestionnaireFilms        Le gestionnaire des films pour lier un film à un log.
+/// \return                         True si toutes les nouvelles lignes ont été interprétées avec succès, false sinon.
+bool AnalyseurLogs::suivreFichier(const std::string& nomFichier,
+                                  const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                  const GestionnaireFilms& gestionnaireFilms)
+{
+    std::ifstream fichier(nomFichier, std::ios::binary | std::ios::ate);
+    if (!fichier)
+    {
+        std::cerr << "Erreur AnalyseurLogs: le fichier " << nomFichier << " n'a pas pu être ouvert\n";
+        return false;
+    }
+    auto tailleFichier = static_cast<std::uint64_t>(fichier.tellg());
+    if (nomFichier != fichierSuivi_ || tailleFichier < positionSuivi_)
+    {
+        fichierSuivi_ = nomFichier;
+        positionSuivi_ = 0;
+    }
+    if (tailleFichier == positionSuivi_)
+    {
+        return true;
+    }
+
+    std::string nouveauTexte(static_cast<std::size_t>(tailleFichier - positionSuivi_), '\0');
+    fichier.seekg(static_cast<std::streamoff>(positionSuivi_));
+    fichier.read(nouveauTexte.data(), static_cast<std::streamsize>(nouveauTexte.size()));
+    nouveauTexte.resize(static_cast<std::size_t>(fichier.gcount()));
+    std::size_t finDerniereLigne = nouveauTexte.rfind('\n');
+    if (finDerniereLigne == std::string::npos)
+    {
+        return true;
+    }
+    nouveauTexte.resize(finDerniereLigne + 1);
+    positionSuivi_ += nouveauTexte.size();
+
+    std::vector<LigneLog> lignesLog;
+    std::string messagesErreur;
+    bool succesParsing =
+        interpreterLignes(nouveauTexte, gestionnaireUtilisateurs, gestionnaireFilms, lignesLog, messagesErreur);
+    std::cerr << messagesErreur;
+    ajouterLignesLog(std::move(lignesLog), gestionnaireUtilisateurs, gestionnaireFilms);
+    return succesParsing;
+}
+
+/// Sauvegarde les logs dans un instantané binaire, que chargerInstantane recharge sans interpréter de texte. Les
+/// colonnes du journal sont écrites telles quelles, avec les compteurs de vues des films et des utilisateurs déjà
+/// calculés. L'instantané n'a de sens qu'avec les gestionnaires qui ont attribué les identifiants denses, sauvegardés
+/// avec leur propre instantané.
+/// \param nomFichier   Le fichier de l'instantané.
+/// \return             True si l'instantané a été écrit avec succès, false sinon.
+bool AnalyseurLogs::sauvegarderInstantane(const std::string& nomFichier) const
+{
+    std::vector<int> nombresVues;
+    nombresVues.reserve(vuesUtilisateurs_.size());
+    std::vector<std::uint64_t> debutsFilmsVus = {0};
+    debutsFilmsVus.reserve(vuesUtilisateurs_.size() + 1);
+    std::vector<IdDense> filmsVus;
+    for (const VuesUtilisateur& vuesUtilisateur : vuesUtilisateurs_)
+    {
+        nombresVues.push_back(vuesUtilisateur.nombreVues);
+        filmsVus.insert(filmsVus.end(), vuesUtilisateur.filmsVus.begin(), vuesUtilisateur.filmsVus.end());
+        debutsFilmsVus.push_back(filmsVus.size());
+    }
+
+    // Les lignes en attente sont sauvegardées avec les autres, dans une copie du journal
+    JournalLogs logsPublies;
+    const JournalLogs* logs = &logs_;
+    if (getNombreLignesEnAttente() > 0)
+    {
+        logsPublies = logs_;
+        publierDans(logsPublies);
+        logs = &logsPublies;
+    }
+
+    EcrivainInstantane ecrivain(ContenuInstantane::Logs);
+    ecrivain.ajouterSection(logs->getTimestamps());
+    ecrivain.ajouterSection(logs->getIdsUtilisateurs());
+    ecrivain.ajouterSection(logs->getIdsFilms());
+    ecrivain.ajouterSection(vuesFilms_);
+    ecrivain.ajouterSection(nombresVues);
+    ecrivain.ajouterSection(debutsFilmsVus);
+    ecrivain.ajouterSection(filmsVus);
+    if (!ecrivain.ecrire(nomFichier))
+    {
+        std::cerr << "Erreur AnalyseurLogs: l'instantané " << nomFichier << " n'a pas pu être écrit\n";
+        return false;
+    }
+    return true;
+}
+
+/// Remplace les logs de l'analyseur par ceux d'un instantané écrit par sauvegarderInstantane. Les colonnes et les
+/// compteurs sont copiés tels quels; seuls le classement et les ensembles de films vus sont reconstruits. Les
+/// gestionnaires doivent avoir été chargés à partir des instantanés sauvegardés en même temps que celui-ci, ou des
+/// mêmes fichiers, pour que les identifiants denses désignent les mêmes films et utilisateurs.
+/// \param nomFichier               Le fichier de l'instantané.
+/// \param gestionnaireUtilisateurs Le gestionnaire des utilisateurs des logs.
+/// \param gestionnaireFilms        Le gestionnaire des films des logs.
+/// \return                         True si l'instantané a été chargé avec succès, false sinon (l'analyseur n'est alors
+///                                 pas modifié).
+bool AnalyseurLogs::chargerInstantane(const std::string& nomFichier,
+                                      const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                      const GestionnaireFilms& gestionnaireFilms)
+{
+    LecteurInstantane lecteur(nomFichier, ContenuInstantane::Logs);
+    std::vector<Timestamp> timestamps;
+    std::vector<IdDense> idsUtilisateurs;
+    std::vector<IdDense> idsFilms;
+    std::vector<int> vuesFilms;
+    std::vector<int> nombresVues;
+    std::vector<std::uint64_t> debutsFilmsVus;
+    std::vector<IdDense> filmsVus;
+    bool succesChargement = lecteur.estValide() && lecteur.getNombreSections() == 7 &&
+                            lecteur.lireSection(0, timestamps) && lecteur.lireSection(1, idsUtilisateurs) &&
+                            lecteur.lireSection(2, idsFilms) && lecteur.lireSection(3, vuesFilms) &&
+                            lecteur.lireSection(4, nombresVues) && lecteur.lireSection(5, debutsFilmsVus) &&
+                            lecteur.lireSection(6, filmsVus);
+
+    // Les identifiants doivent désigner des films et des utilisateurs présents dans les gestionnaires
+    auto sontInferieurs = [](const std::vector<IdDense>& ids, std::size_t borne) {
+        return std::all_of(ids.begin(), ids.end(), [borne](IdDense id) { return id < borne; });
+    };
+    succesChargement = succesChargement && vuesFilms.size() <= gestionnaireFilms.getNombreIdsDenses() &&
+                       nombresVues.size() <= gestionnaireUtilisateurs.getNombreIdsDenses() &&
+                       debutsFilmsVus.size() == nombresVues.size() + 1 && debutsFilmsVus.front() == 0 &&
+                       debutsFilmsVus.back() == filmsVus.size() &&
+                       std::is_sorted(debutsFilmsVus.begin(), debutsFilmsVus.end()) &&
+                       sontInferieurs(idsFilms, vuesFilms.size()) && sontInferieurs(filmsVus, vuesFilms.size()) &&
+                       sontInferieurs(idsUtilisateurs, nombresVues.size());
+    for (std::size_t idFilm = 0; succesChargement && idFilm < vuesFilms.size(); idFilm++)
+    {
+        succesChargement =
+            vuesFilms[idFilm] == 0 || gestionnaireFilms.getFilmParIdDense(static_cast<IdDense>(idFilm)) != nullptr;
+    }
+    for (std::size_t idUtilisateur = 0; succesChargement && idUtilisateur < nombresVues.size(); idUtilisateur++)
+    {
+        succesChargement = nombresVues[idUtilisateur] == 0 ||
+                           gestionnaireUtilisateurs.getUtilisateurParIdDense(static_cast<IdDense>(idUtilisateur)) !=
+                               nullptr;
+    }
+    if (!succesChargement || !logs_.assigner(std::move(timestamps), std::move(idsUtilisateurs), std::move(idsFilms)))
+    {
+        std::cerr << "Erreur AnalyseurLogs: l'instantané " << nomFichier << " n'a pas pu être chargé\n";
+        return false;
+    }
+
+    lignesEnAttente_.clear();
+    lignesEnRetard_.clear();
+    nombreLignesEnRetard_ = 0;
+    producteurs_.reinitialiser();
+    associerGestionnaires(gestionnaireUtilisateurs, gestionnaireFilms);
+    vuesFilms_ = std::move(vuesFilms);
+    vuesFilms_.resize(films_.size(), 0);
+    vuesUtilisateurs_.assign(utilisateurs_.size(), VuesUtilisateur());
+    for (std::size_t idUtilisateur = 0; idUtilisateur < nombresVues.size(); idUtilisateur++)
+    {
+        VuesUtilisateur& vuesUtilisateur = vuesUtilisateurs_[idUtilisateur];
+        vuesUtilisateur.nombreVues = nombresVues[idUtilisateur];
+        auto debut = std::next(filmsVus.begin(), static_cast<std::ptrdiff_t>(debutsFilmsVus[idUtilisateur]));
+        auto fin = std::next(filmsVus.begin(), static_cast<std::ptrdiff_t>(debutsFilmsVus[idUtilisateur + 1]));
+        vuesUtilisateur.filmsVus.reserve(static_cast<std::size_t>(fin - debut));
+        vuesUtilisateur.filmsVus.insert(debut, fin);
+    }
+    classementFilms_.reconstruire(vuesFilms_);
+    publication_.journalAPublier = true;
+    publierStatistiques();
+    return true;
+}
+
+/// Renumérote les logs et les compteurs après la compaction des identifiants denses des gestionnaires (voir
+/// GestionnaireFilms::compacterIdsDenses), pour que les tableaux indexés par identifiant rétrécissent eux aussi. Les
+/// lignes en attente sont d'abord publiées et les lignes produites intégrées; aucun producteur ne doit exister. Les
+/// lignes d'un film ou d'un utilisateur supprimé n'ont plus d'identifiant et sont retirées du journal; les compteurs
+/// et le classement sont ensuite recalculés à partir du journal.
+/// \param nouveauxIdsUtilisateurs  Le nouvel identifiant de chaque ancien identifiant d'utilisateur.
+/// \param nouveauxIdsFilms         Le nouvel identifiant de chaque ancien identifiant de film.
+/// \param gestionnaireUtilisateurs Le gestionnaire des utilisateurs, déjà compacté.
+/// \param gestionnaireFilms        Le gestionnaire des films, déjà compacté.
+/// \return                         Le nombre de lignes retirées du journal.
+std::size_t AnalyseurLogs::renumeroterIdsDenses(const std::vector<IdDense>& nouveauxIdsUtilisateurs,
+                                                const std::vector<IdDense>& nouveauxIdsFilms,
+                                                const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                                const GestionnaireFilms& gestionnaireFilms)
+{
+    integrerLignesProduites();
+    producteurs_.reinitialiser();
+    publierLignesEnAttente();
+    auto renumeroter = [](const std::vector<IdDense>& nouveauxIds, IdDense id) {
+        return id < nouveauxIds.size() ? nouveauxIds[id] : idDenseInvalide;
+    };
+    std::vector<Timestamp> timestamps;
+    std::vector<IdDense> idsUtilisateurs;
+    std::vector<IdDense> idsFilms;
+    timestamps.reserve(logs_.getTaille());
+    idsUtilisateurs.reserve(logs_.getTaille());
+    idsFilms.reserve(logs_.getTaille());
+    for (std::size_t i = 0; i < logs_.getTaille(); i++)
+    {
+        LigneLog ligneLog = logs_.getLigneLog(i);
+        IdDense idUtilisateur = renumeroter(nouveauxIdsUtilisateurs, ligneLog.idUtilisateur);
+        IdDense idFilm = renumeroter(nouveauxIdsFilms, ligneLog.idFilm);
+        if (idUtilisateur != idDenseInvalide && idFilm != idDenseInvalide)
+        {
+            timestamps.push_back(ligneLog.timestamp);
+            idsUtilisateurs.push_back(idUtilisateur);
+            idsFilms.push_back(idFilm);
+        }
+    }
+    std::size_t nombreLignesRetirees = logs_.getTaille() - timestamps.size();
+    logs_.assigner(std::move(timestamps), std::move(idsUtilisateurs), std::move(idsFilms));
+
+    associerGestionnaires(gestionnaireUtilisateurs, gestionnaireFilms);
+    vuesFilms_.assign(films_.size(), 0);
+    vuesUtilisateurs_.assign(utilisateurs_.size(), VuesUtilisateur());
+    for (std::size_t i = 0; i < logs_.getTaille(); i++)
+    {
+        IdDense idFilm = logs_.getIdsFilms()[i];
+        VuesUtilisateur& vuesUtilisateur = vuesUtilisateurs_[logs_.getIdsUtilisateurs()[i]];
+        vuesFilms_[idFilm]++;
+        vuesUtilisateur.nombreVues++;
+        vuesUtilisateur.filmsVus.insert(idFilm);
+    }
+    classementFilms_.reconstruire(vuesFilms_);
+    publication_.lignesNonPubliees.clear();
+    publication_.journalAPublier = true;
+    publierStatistiques();
+    return nombreLignesRetirees;
+}
+
 /// Crée et ajoute une ligne de log dans le vecteur de logs
-/// \param timestamp                Ordre de classement du ligneLog dans le vecteur logs_.
+/// \param timestamp                Timestamp ISO-8601 (ex. 2016-04-29T17:12:49Z) servant à classer la ligne de log.
 /// \param idUtilisateur            l'identifiant de l'utilisateur.
 /// \param nomFilm                  le nom du film de la ligneLog.
 /// \param gestionnaireUtilisateurs Référence au gestionnaire des utilisateurs pour lier un utilisateur à un log.
 /// \param gestionnaireFilms        Référence au gestionnaire des films pour pour lier un film à un log.
-/// \return                         True si le film et l’utilisateur existaient et le log a été ajouté avec succès, false sinon.
+/// \return                         True si le timestamp était valide, si le film et l’utilisateur existaient et le log
+///                                 a été ajouté avec succès, false sinon.
 bool AnalyseurLogs::creerLigneLog(const std::string& timestamp, const std::string& idUtilisateur, const std::string& nomFilm,
 	GestionnaireUtilisateurs& gestionnaireUtilisateurs, GestionnaireFilms& gestionnaireFilms)
 {
-	LigneLog ligneLog = {timestamp, (gestionnaireUtilisateurs.getUtilisateurParId(idUtilisateur)), (gestionnaireFilms.getFilmParNom(nomFilm))};
-	if (gestionnaireFilms.getFilmParNom(nomFilm) == nullptr || gestionnaireUtilisateurs.getUtilisateurParId(idUtilisateur) == nullptr)
+	std::optional<Timestamp> timestampConverti = convertirTimestamp(timestamp);
+	const Utilisateur* utilisateur = gestionnaireUtilisateurs.getUtilisateurParId(idUtilisateur);
+	const Film* film = gestionnaireFilms.getFilmParNom(nomFilm);
+	if (!timestampConverti || film == nullptr || utilisateur == nullptr)
 	{
 		return false;
 	}
-	ajouterLigneLog(ligneLog);
-	return std::binary_search(logs_.begin(), logs_.end(), ligneLog, ComparateurLog());
+	return ajouterLigneLog(LigneLog{*timestampConverti, utilisateur->idDense, film->idDense},
+	                       gestionnaireUtilisateurs, gestionnaireFilms);
 }
 
 /// Ajoute une ligne de log en ordre chronologique dans le vecteur de logs tout en mettant à jour le nombre de vues.
+/// Sans retard maximal, la ligne est insérée à sa place, après les lignes ayant le même timestamp comme avec
+/// ajouterLignesLog, ce qui décale toutes les lignes plus récentes; avec un retard maximal, elle passe par les lignes
+/// en attente (voir setRetardMaximal). Les compteurs de vues sont mis à jour dans
+/// les deux cas dès l'ajout.
 /// \param ligneLog                 ligne de log à ajouter dans le vecteur de logs_.
-/// \return                         Aucune valeur de retour.
-void AnalyseurLogs::ajouterLigneLog(const LigneLog& ligneLog)
+/// \param gestionnaireUtilisateurs Gestionnaire ayant attribué l'identifiant dense de l'utilisateur de la ligne.
+/// \param gestionnaireFilms        Gestionnaire ayant attribué l'identifiant dense du film de la ligne.
+/// \return                         True si l'utilisateur et le film de la ligne existaient et le log a été ajouté,
+///                                 false sinon.
+bool AnalyseurLogs::ajouterLigneLog(const LigneLog& ligneLog, const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+	const GestionnaireFilms& gestionnaireFilms)
+{
+	if (!enregistrerLigneLog(ligneLog, gestionnaireUtilisateurs, gestionnaireFilms))
+	{
+		return false;
+	}
+
+	if (!logs_.estVide() && ligneLog.timestamp < logs_.getTimestamps().back())
+	{
+		nombreLignesEnRetard_++;
+	}
+	if (retardMaximal_ == 0)
+	{
+		//Insertion de la ligneLog dans le journal logs_
+		logs_.inserer(ligneLog);
+	}
+	else
+	{
+		mettreEnAttente(ligneLog);
+	}
+
+	//Incrémenter le nombre de vues du Film et de l'utilisateur de ligneLog
+	compterVue(ligneLog);
+	return true;
+}
+
+/// Ajoute un lot de lignes de log en ordre chronologique dans le journal de logs tout en mettant à jour le nombre de
+/// vues. Le lot est trié une seule fois puis fusionné avec les logs existants (voir JournalLogs::fusionner), ce qui
+/// coûte O(n log n) plutôt que O(n²) pour n insertions successives avec ajouterLigneLog.
+/// Les lignes ayant le même timestamp conservent l'ordre du lot et suivent les lignes déjà présentes. Les lignes en
+/// attente sont publiées avant la fusion.
+/// \param lignesLog                Lignes de log à ajouter, dans n'importe quel ordre.
+/// \param gestionnaireUtilisateurs Gestionnaire ayant attribué les identifiants denses des utilisateurs des lignes.
+/// \param gestionnaireFilms        Gestionnaire ayant attribué les identifiants denses des films des lignes.
+/// \return                         True si toutes les lignes ont été ajoutées, false si certaines ont été ignorées
+///                                 parce que leur utilisateur ou leur film n'existait pas.
+bool AnalyseurLogs::ajouterLignesLog(std::vector<LigneLog> lignesLog,
+                                     const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                     const GestionnaireFilms& gestionnaireFilms)
+{
+    auto finValides = std::remove_if(lignesLog.begin(), lignesLog.end(), [&](const LigneLog& ligneLog) {
+        return !enregistrerLigneLog(ligneLog, gestionnaireUtilisateurs, gestionnaireFilms);
+    });
+    bool toutesAjoutees = finValides == lignesLog.end();
+    lignesLog.erase(finValides, lignesLog.end());
+    if (lignesLog.empty())
+    {
+        return toutesAjoutees;
+    }
+
+    for (const LigneLog& ligneLog : lignesLog)
+    {
+        compterVue(ligneLog);
+    }
+    publierLignesEnAttente();
+    logs_.fusionner(std::move(lignesLog));
+    publierStatistiques();
+    return toutesAjoutees;
+}
+
+/// Ajoute des lots de lignes de log reçus de plusieurs producteurs. Chaque lot est ajouté par son propre producteur
+/// (voir creerProducteur), et au plus getNombreThreads() threads se partagent les lots: les vues sont comptées en
+/// parallèle dans les compteurs répartis, puis les lignes sont intégrées en un seul passage. Le résultat est le même
+/// qu'un appel à ajouterLignesLog avec les lots mis bout à bout.
+/// \param lotsLog                  Les lots de lignes de log, un par producteur, chacun dans n'importe quel ordre.
+/// \param gestionnaireUtilisateurs Gestionnaire ayant attribué les identifiants denses des utilisateurs des lignes.
+/// \param gestionnaireFilms        Gestionnaire ayant attribué les identifiants denses des films des lignes.
+/// \return                         True si toutes les lignes ont été ajoutées, false si certaines ont été ignorées
+///                                 parce que leur utilisateur ou leur film n'existait pas.
+bool AnalyseurLogs::ajouterLotsLog(std::vector<std::vector<LigneLog>> lotsLog,
+                                   const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                   const GestionnaireFilms& gestionnaireFilms)
+{
+    if (lotsLog.empty())
+    {
+        return true;
+    }
+
+    // Les producteurs sont créés dans l'ordre des lots pour que les lignes de même timestamp gardent cet ordre
+    std::vector<Producteur> producteurs;
+    producteurs.reserve(lotsLog.size());
+    for (std::size_t i = 0; i < lotsLog.size(); i++)
+    {
+        producteurs.push_back(creerProducteur(gestionnaireUtilisateurs, gestionnaireFilms));
+    }
+
+    std::atomic<std::size_t> prochainLot{0};
+    std::atomic<bool> toutesAjoutees{true};
+    auto ajouterLots = [&]() {
+        for (std::size_t lot = prochainLot.fetch_add(1, std::memory_order_relaxed); lot < lotsLog.size();
+             lot = prochainLot.fetch_add(1, std::memory_order_relaxed))
+        {
+            bool lotAjoute = true;
+            for (const LigneLog& ligneLog : lotsLog[lot])
+            {
+                lotAjoute = producteurs[lot].ajouterLigneLog(ligneLog) && lotAjoute;
+            }
+            producteurs[lot].transmettre();
+            if (!lotAjoute)
+            {
+                toutesAjoutees.store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+    std::size_t nombreThreads = std::min<std::size_t>(getNombreThreads(), lotsLog.size());
+    std::vector<std::thread> threads;
+    threads.reserve(nombreThreads - 1);
+    for (std::size_t i = 1; i < nombreThreads; i++)
+    {
+        threads.emplace_back(ajouterLots);
+    }
+    ajouterLots();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    integrerLignesProduites();
+    return toutesAjoutees.load(std::memory_order_relaxed);
+}
+
+/// Crée un producteur, qui permet à un autre thread d'ajouter des lignes de log pendant que l'analyseur est utilisé.
+/// Doit être appelée par le thread qui possède l'analyseur. Les producteurs comptent leurs vues dans des compteurs
+/// répartis en au plus getNombreThreads() fragments; les producteurs en surplus partagent un fragment. Les vues sont
+/// lues dès leur ajout par getNombreVuesFilm, getNombreVuesPourUtilisateur, getFilmPlusPopulaire et
+/// getNFilmsPlusPopulaires, qui restent donc cohérentes entre elles; les films vus, les requêtes sur un intervalle de
+/// temps, les statistiques publiées, les instantanés et le journal ne voient les lignes produites qu'une fois
+/// intégrées par integrerLignesProduites. Tant qu'il reste des vues produites non intégrées, les deux requêtes sur les
+/// films les plus populaires parcourent tous les films, en O(F × fragments) plutôt qu'en O(1) ou O(nombre).
+/// Les gestionnaires ne doivent pas être modifiés tant qu'un producteur existe, et chargerDepuisFichier,
+/// chargerInstantane et renumeroterIdsDenses ne doivent pas être appelées: les deux premières abandonnent les lignes
+/// produites qui n'ont pas été intégrées.
+/// \param gestionnaireUtilisateurs Gestionnaire ayant attribué les identifiants denses des utilisateurs des lignes.
+/// \param gestionnaireFilms        Gestionnaire ayant attribué les identifiants denses des films des lignes.
+/// \return                         Le producteur.
+AnalyseurLogs::Producteur AnalyseurLogs::creerProducteur(const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                                         const GestionnaireFilms& gestionnaireFilms)
+{
+    if (producteurs_.nombreProducteurs.load(std::memory_order_acquire) == 0)
+    {
+        // Sans producteur, toutes les lignes comptées ont été transmises: une fois intégrées, les compteurs répartis
+        // sont à 0 et peuvent être remplacés si les gestionnaires ont attribué de nouveaux identifiants
+        integrerLignesProduites();
+        associerGestionnaires(gestionnaireUtilisateurs, gestionnaireFilms);
+        vuesFilms_.resize(films_.size(), 0);
+        vuesUtilisateurs_.resize(utilisateurs_.size());
+        if (producteurs_.vuesFilms == nullptr || producteurs_.vuesFilms->getNombreCompteurs() != films_.size() ||
+            producteurs_.vuesUtilisateurs->getNombreCompteurs() != utilisateurs_.size())
+        {
+            producteurs_.vuesFilms = std::make_unique<CompteursRepartis>(films_.size(), getNombreThreads());
+            producteurs_.vuesUtilisateurs = std::make_unique<CompteursRepartis>(utilisateurs_.size(),
+                                                                               getNombreThreads());
+        }
+    }
+    producteurs_.nombreProducteurs.fetch_add(1, std::memory_order_relaxed);
+    return Producteur(*this, producteurs_.prochainNumero++, gestionnaireUtilisateurs, gestionnaireFilms);
+}
+
+/// Intègre les lignes transmises par les producteurs: elles sont ajoutées au journal comme avec ajouterLignesLog et
+/// leurs vues passent des compteurs répartis aux compteurs et au classement de l'analyseur, une vue à la fois comme
+/// avec ajouterLigneLog, en temps proportionnel au nombre de lignes. À timestamp égal, les lignes suivent celles déjà
+/// présentes, puis l'ordre de création de leurs producteurs et l'ordre de leur ajout. Doit être appelée par le thread
+/// qui possède l'analyseur, pendant que les producteurs continuent d'ajouter.
+/// \return                         Le nombre de lignes intégrées.
+std::size_t AnalyseurLogs::integrerLignesProduites()
+{
+    std::vector<std::pair<std::size_t, std::vector<LigneLog>>> lots;
+    {
+        std::lock_guard<std::mutex> verrou(producteurs_.mutexLots);
+        lots.swap(producteurs_.lotsTransmis);
+    }
+    if (lots.empty())
+    {
+        return 0;
+    }
+
+    std::stable_sort(lots.begin(), lots.end(), [](const auto& lot1, const auto& lot2) {
+        return lot1.first < lot2.first;
+    });
+    std::size_t nombreLignes = 0;
+    for (const auto& lot : lots)
+    {
+        nombreLignes += lot.second.size();
+    }
+    std::vector<LigneLog> lignesLog;
+    lignesLog.reserve(nombreLignes);
+    for (const auto& [numero, lignesLot] : lots)
+    {
+        for (const LigneLog& ligneLog : lignesLot)
+        {
+            producteurs_.vuesFilms->decrementer(ligneLog.idFilm, numero);
+            producteurs_.vuesUtilisateurs->decrementer(ligneLog.idUtilisateur, numero);
+            vuesFilms_[ligneLog.idFilm]++;
+            classementFilms_.incrementer(ligneLog.idFilm);
+            VuesUtilisateur& vuesUtilisateur = vuesUtilisateurs_[ligneLog.idUtilisateur];
+            vuesUtilisateur.nombreVues++;
+            vuesUtilisateur.filmsVus.insert(ligneLog.idFilm);
+            lignesLog.push_back(ligneLog);
+        }
+    }
+
+    if (publication_.publication != nullptr && !publication_.journalAPublier)
+    {
+        publication_.lignesNonPubliees.insert(publication_.lignesNonPubliees.end(), lignesLog.begin(),
+                                              lignesLog.end());
+    }
+    publierLignesEnAttente();
+    logs_.fusionner(std::move(lignesLog));
+    publierStatistiques();
+    return nombreLignes;
+}
+
+/// Constructeur, appelé par creerProducteur.
+/// \param analyseurLogs            L'analyseur qui reçoit les lignes.
+/// \param numero                   L'ordre de création du producteur.
+/// \param gestionnaireUtilisateurs Gestionnaire ayant attribué les identifiants denses des utilisateurs des lignes.
+/// \param gestionnaireFilms        Gestionnaire ayant attribué les identifiants denses des films des lignes.
+AnalyseurLogs::Producteur::Producteur(AnalyseurLogs& analyseurLogs,
+                                      std::size_t numero,
+                                      const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                      const GestionnaireFilms& gestionnaireFilms)
+    : analyseurLogs_(&analyseurLogs)
+    , gestionnaireUtilisateurs_(&gestionnaireUtilisateurs)
+    , gestionnaireFilms_(&gestionnaireFilms)
+    , numero_(numero)
+{
+}
+
+/// Constructeur par déplacement. Le producteur déplacé ne peut plus être utilisé.
+/// \param other                    Le producteur à déplacer.
+AnalyseurLogs::Producteur::Producteur(Producteur&& other) noexcept
+    : analyseurLogs_(std::exchange(other.analyseurLogs_, nullptr))
+    , gestionnaireUtilisateurs_(other.gestionnaireUtilisateurs_)
+    , gestionnaireFilms_(other.gestionnaireFilms_)
+    , numero_(other.numero_)
+    , lignesLog_(std::move(other.lignesLog_))
+{
+}
+
+/// Destructeur. Transmet les dernières lignes à l'analyseur.
+AnalyseurLogs::Producteur::~Producteur()
+{
+    if (analyseurLogs_ != nullptr)
+    {
+        transmettre();
+        analyseurLogs_->producteurs_.nombreProducteurs.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+/// Ajoute une ligne de log: ses vues sont comptées aussitôt et la ligne est transmise à l'analyseur avec les suivantes
+/// par lots de tailleLotProducteur lignes.
+/// \param ligneLog                 La ligne de log à ajouter.
+/// \return                         True si l'utilisateur et le film de la ligne existaient et la ligne a été ajoutée,
+///                                 false sinon.
+bool AnalyseurLogs::Producteur::ajouterLigneLog(const LigneLog& ligneLog)
+{
+    EtatProducteurs& etat = analyseurLogs_->producteurs_;
+    if (ligneLog.idFilm >= etat.vuesFilms->getNombreCompteurs() ||
+        ligneLog.idUtilisateur >= etat.vuesUtilisateurs->getNombreCompteurs() ||
+        gestionnaireUtilisateurs_->getUtilisateurParIdDense(ligneLog.idUtilisateur) == nullptr ||
+        gestionnaireFilms_->getFilmParIdDense(ligneLog.idFilm) == nullptr)
+    {
+        return false;
+    }
+
+    etat.vuesFilms->incrementer(ligneLog.idFilm, numero_);
+    etat.vuesUtilisateurs->incrementer(ligneLog.idUtilisateur, numero_);
+    lignesLog_.push_back(ligneLog);
+    if (lignesLog_.size() >= tailleLotProducteur)
+    {
+        transmettre();
+    }
+    return true;
+}
+
+/// Transmet à l'analyseur les lignes ajoutées depuis la dernière transmission, pour que la prochaine intégration les
+/// ajoute au journal.
+void AnalyseurLogs::Producteur::transmettre()
+{
+    if (lignesLog_.empty())
+    {
+        return;
+    }
+    EtatProducteurs& etat = analyseurLogs_->producteurs_;
+    std::lock_guard<std::mutex> verrou(etat.mutexLots);
+    etat.lotsTransmis.emplace_back(numero_, std::move(lignesLog_));
+    lignesLog_.clear();
+}
+
+/// Place une ligne parmi les lignes en attente, puis ajoute à la fin du journal celles que le filigrane a dépassées: le
+/// filigrane est le plus grand timestamp reçu moins le retard maximal, et une ligne qui le précède ne peut plus être
+/// devancée que par une ligne en retard. Une ligne plus ancienne que la dernière ligne du journal est en retard; elle
+/// est gardée à part et les lignes en retard sont fusionnées au journal par lots, en un passage par lot plutôt qu'un
+/// décalage de toutes les lignes plus récentes pour chacune.
+/// \param ligneLog     La ligne à ajouter, dont l'utilisateur et le film sont connus de l'analyseur.
+void AnalyseurLogs::mettreEnAttente(const LigneLog& ligneLog)
+{
+    if (!logs_.estVide() && ligneLog.timestamp < logs_.getTimestamps().back())
+    {
+        lignesEnRetard_.push_back(ligneLog);
+        if (lignesEnRetard_.size() >= tailleLotLignesEnRetard)
+        {
+            logs_.fusionner(std::move(lignesEnRetard_));
+            lignesEnRetard_.clear();
+        }
+        return;
+    }
+
+    lignesEnAttente_.insert(std::upper_bound(lignesEnAttente_.begin(), lignesEnAttente_.end(), ligneLog,
+                                             ComparateurLog()),
+                            ligneLog);
+    Timestamp filigrane = lignesEnAttente_.back().timestamp - retardMaximal_;
+    auto finPubliees = std::upper_bound(lignesEnAttente_.begin(), lignesEnAttente_.end(), filigrane,
+                                        [](Timestamp timestamp, const LigneLog& autre) {
+                                            return timestamp < autre.timestamp;
+                                        });
+    for (auto it = lignesEnAttente_.begin(); it != finPubliees; ++it)
+    {
+        logs_.ajouterALaFin(*it);
+    }
+    lignesEnAttente_.erase(lignesEnAttente_.begin(), finPubliees);
+}
+
+/// Ajoute à un journal toutes les lignes en attente et en retard de l'analyseur.
+/// \param logs         Le journal de l'analyseur ou une copie de celui-ci.
+void AnalyseurLogs::publierDans(JournalLogs& logs) const
+{
+    for (const LigneLog& ligneLog : lignesEnAttente_)
+    {
+        logs.ajouterALaFin(ligneLog);
+    }
+    if (!lignesEnRetard_.empty())
+    {
+        logs.fusionner(lignesEnRetard_);
+    }
+}
+
+/// Appelle une fonction sur chaque ligne en attente ou en retard comprise dans un intervalle de temps, pour que les
+/// statistiques sur un intervalle comptent aussi les lignes qui ne sont pas encore dans le journal.
+/// \param debut        Début de l'intervalle, inclus.
+/// \param fin          Fin de l'intervalle, incluse.
+/// \param fonction     La fonction appelée sur chaque ligne.
+template<typename Fonction>
+void AnalyseurLogs::pourChaqueLigneNonPubliee(Timestamp debut, Timestamp fin, Fonction fonction) const
+{
+    for (const std::vector<LigneLog>* lignesLog : {&lignesEnAttente_, &lignesEnRetard_})
+    {
+        for (const LigneLog& ligneLog : *lignesLog)
+        {
+            if (ligneLog.timestamp >= debut && ligneLog.timestamp <= fin)
+            {
+                fonction(ligneLog);
+            }
+        }
+    }
+}
+
+/// Remplit les répertoires des films et des utilisateurs de l'analyseur à partir de tous les identifiants denses
+/// attribués par les gestionnaires.
+/// \param gestionnaireUtilisateurs Le gestionnaire des utilisateurs des logs.
+/// \param gestionnaireFilms        Le gestionnaire des films des logs.
+void AnalyseurLogs::associerGestionnaires(const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                          const GestionnaireFilms& gestionnaireFilms)
+{
+    films_.resize(gestionnaireFilms.getNombreIdsDenses());
+    for (std::size_t idFilm = 0; idFilm < films_.size(); idFilm++)
+    {
+        films_[idFilm] = gestionnaireFilms.getFilmParIdDense(static_cast<IdDense>(idFilm));
+    }
+    utilisateurs_.resize(gestionnaireUtilisateurs.getNombreIdsDenses());
+    for (std::size_t idUtilisateur = 0; idUtilisateur < utilisateurs_.size(); idUtilisateur++)
+    {
+        utilisateurs_[idUtilisateur] =
+            gestionnaireUtilisateurs.getUtilisateurParIdDense(static_cast<IdDense>(idUtilisateur));
+    }
+}
+
+/// Vérifie que l'utilisateur et le film d'une ligne de log existent et les enregistre dans les tableaux indexés par
+/// identifiant dense, en agrandissant ceux-ci au besoin.
+/// \param ligneLog                 La ligne de log à enregistrer.
+/// \param gestionnaireUtilisateurs Gestionnaire ayant attribué l'identifiant dense de l'utilisateur de la ligne.
+/// \param gestionnaireFilms        Gestionnaire ayant attribué l'identifiant dense du film de la ligne.
+/// \return                         True si l'utilisateur et le film existaient, false sinon.
+bool AnalyseurLogs::enregistrerLigneLog(const LigneLog& ligneLog,
+                                        const GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                        const GestionnaireFilms& gestionnaireFilms)
+{
+    const Utilisateur* utilisateur = gestionnaireUtilisateurs.getUtilisateurParIdDense(ligneLog.idUtilisateur);
+    const Film* film = gestionnaireFilms.getFilmParIdDense(ligneLog.idFilm);
+    if (utilisateur == nullptr || film == nullptr)
+    {
+        return false;
+    }
+
+    if (ligneLog.idFilm >= films_.size())
+    {
+        films_.resize(gestionnaireFilms.getNombreIdsDenses(), nullptr);
+        vuesFilms_.resize(films_.size(), 0);
+    }
+    films_[ligneLog.idFilm] = film;
+    if (ligneLog.idUtilisateur >= utilisateurs_.size())
+    {
+        utilisateurs_.resize(gestionnaireUtilisateurs.getNombreIdsDenses(), nullptr);
+        vuesUtilisateurs_.resize(utilisateurs_.size());
+    }
+    utilisateurs_[ligneLog.idUtilisateur] = utilisateur;
+    return true;
+}
+
+/// Met à jour le nombre de vues et le classement du film ainsi que l'index des vues de l'utilisateur d'une ligne de log
+/// déjà enregistrée.
+/// \param ligneLog                 La ligne de log ajoutée.
+void AnalyseurLogs::compterVue(const LigneLog& ligneLog)
+{
+    vuesFilms_[ligneLog.idFilm]++;
+    classementFilms_.incrementer(ligneLog.idFilm);
+    VuesUtilisateur& vuesUtilisateur = vuesUtilisateurs_[ligneLog.idUtilisateur];
+    vuesUtilisateur.nombreVues++;
+    vuesUtilisateur.filmsVus.insert(ligneLog.idFilm);
+    if (publication_.publication != nullptr && !publication_.journalAPublier)
+    {
+        publication_.lignesNonPubliees.push_back(ligneLog);
+    }
+}
+
+/// Indique si des vues comptées par les producteurs n'ont peut-être pas encore été intégrées, ce qui est le cas tant
+/// qu'un producteur existe ou qu'un lot transmis attend son intégration.
+/// \return                         True si les compteurs répartis peuvent contenir des vues, false sinon.
+bool AnalyseurLogs::aVuesProduites() const
+{
+    if (producteurs_.vuesFilms == nullptr)
+    {
+        return false;
+    }
+    // Un producteur transmet ses dernières lignes avant de se retirer du nombre de producteurs
+    if (producteurs_.nombreProducteurs.load(std::memory_order_acquire) > 0)
+    {
+        return true;
+    }
+    std::lock_guard<std::mutex> verrou(producteurs_.mutexLots);
+    return !producteurs_.lotsTransmis.empty();
+}
+
+/// Retourne les films les plus regardés et leur nombre de vues. Sans vues produites en attente, c'est le début du
+/// classement, en O(nombre). Sinon, le nombre de vues de chaque film est additionné à celui de ses compteurs
+/// répartis, puis les premiers sont choisis en O(F × fragments + F log(nombre)); à nombre de vues égal, les films
+/// gardent leur ordre dans le classement, suivi des films qui n'y sont pas encore, par identifiant dense.
+/// \param nombre                   Nombre de films à retourner.
+/// \return                         Les identifiants denses des films et leur nombre de vues, en ordre décroissant.
+std::vector<std::pair<IdDense, int>> AnalyseurLogs::getPremiersFilms(std::size_t nombre) const
+{
+    if (!aVuesProduites())
+    {
+        return classementFilms_.getPremiers(nombre);
+    }
+
+    struct FilmClasse
+    {
+        int nombreVues;
+        std::size_t rang; // Position dans le classement, ou après le classement pour un film qui n'y est pas
+        IdDense idFilm;
+    };
+    const CompteursRepartis& vuesProduites = *producteurs_.vuesFilms;
+    std::vector<std::pair<IdDense, int>> classement = classementFilms_.getPremiers(vuesFilms_.size());
+    std::vector<FilmClasse> films;
+    films.reserve(classement.size());
+    for (std::size_t rang = 0; rang < classement.size(); rang++)
+    {
+        auto [idFilm, nombreVues] = classement[rang];
+        if (idFilm < vuesProduites.getNombreCompteurs())
+        {
+            nombreVues += static_cast<int>(vuesProduites.getTotal(idFilm));
+        }
+        films.push_back(FilmClasse{nombreVues, rang, idFilm});
+    }
+    for (std::size_t idFilm = 0; idFilm < vuesProduites.getNombreCompteurs(); idFilm++)
+    {
+        if (vuesFilms_[idFilm] == 0)
+        {
+            int nombreVues = static_cast<int>(vuesProduites.getTotal(idFilm));
+            if (nombreVues > 0)
+            {
+                films.push_back(FilmClasse{nombreVues, classement.size() + idFilm, static_cast<IdDense>(idFilm)});
+            }
+        }
+    }
+
+    auto fin = std::next(films.begin(), static_cast<std::ptrdiff_t>(std::min(nombre, films.size())));
+    std::partial_sort(films.begin(), fin, films.end(), [](const FilmClasse& film1, const FilmClasse& film2) {
+        return film1.nombreVues > film2.nombreVues ||
+               (film1.nombreVues == film2.nombreVues && film1.rang < film2.rang);
+    });
+    std::vector<std::pair<IdDense, int>> premiers;
+    premiers.reserve(static_cast<std::size_t>(fin - films.begin()));
+    for (auto film = films.begin(); film != fin; ++film)
+    {
+        premiers.emplace_back(film->idFilm, film->nombreVues);
+    }
+    return premiers;
+}
+
+/// Retourne l'identifiant dense d'un film connu de l'analyseur.
+/// \param film                     Le film.
+/// \return                         L'identifiant dense du film, ou idDenseInvalide si le film est nul ou n'appartient
+///                                 pas aux gestionnaires dont proviennent les logs.
+IdDense AnalyseurLogs::getIdFilm(const Film* film) const
+{
+    if (film == nullptr || film->idDense >= films_.size() || films_[film->idDense] != film)
+    {
+        return idDenseInvalide;
+    }
+    return film->idDense;
+}
+
+/// Retourne l'identifiant dense d'un utilisateur connu de l'analyseur.
+/// \param utilisateur              L'utilisateur.
+/// \return                         L'identifiant dense de l'utilisateur, ou idDenseInvalide si l'utilisateur est nul
+///                                 ou n'appartient pas aux gestionnaires dont proviennent les logs.
+IdDense AnalyseurLogs::getIdUtilisateur(const Utilisateur* utilisateur) const
+{
+    if (utilisateur == nullptr || utilisateur->idDense >= utilisateurs_.size() ||
+        utilisateurs_[utilisateur->idDense] != utilisateur)
+    {
+        return idDenseInvalide;
+    }
+    return utilisateur->idDense;
+}
+
+/// Change le nombre de threads utilisés par chargerDepuisFichier et ajouterLotsLog, qui donne aussi le nombre de
+/// fragments des compteurs répartis des producteurs.
+/// \param nombreThreads    Le nombre de threads, ou 0 pour en utiliser autant que de coeurs.
+void AnalyseurLogs::setNombreThreads(unsigned int nombreThreads)
+{
+    nombreThreads_ = nombreThreads;
+}
+
+/// Retourne le nombre de threads utilisés par chargerDepuisFichier et ajouterLotsLog.
+/// \return Le nombre de threads, au moins 1.
+unsigned int AnalyseurLogs::getNombreThreads() const
+{
+    if (nombreThreads_ != 0)
+    {
+        return nombreThreads_;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/// Change le retard maximal des lignes ajoutées une à une par ajouterLigneLog. Avec un retard maximal, une ligne
+/// attend dans un petit tampon trié jusqu'à ce qu'une ligne plus récente d'au moins ce retard soit reçue, puis est
+/// ajoutée à la fin du journal sans rien décaler. Les lignes en attente sont publiées avant le changement.
+/// \param retardMaximal    Le retard maximal, en secondes, ou 0 pour insérer chaque ligne à sa place dès son ajout.
+void AnalyseurLogs::setRetardMaximal(Timestamp retardMaximal)
+{
+    publierLignesEnAttente();
+    retardMaximal_ = std::max<Timestamp>(retardMaximal, 0);
+}
+
+/// Retourne le retard maximal des lignes ajoutées une à une.
+/// \return                 Le retard maximal, en secondes.
+Timestamp AnalyseurLogs::getRetardMaximal() const
+{
+    return retardMaximal_;
+}
+
+/// Ajoute au journal toutes les lignes en attente et en retard, par exemple à la fin d'un flux de logs.
+void AnalyseurLogs::publierLignesEnAttente()
+{
+    publierDans(logs_);
+    lignesEnAttente_.clear();
+    lignesEnRetard_.clear();
+}
+
+/// Retourne le nombre de lignes reçues qui ne sont pas encore dans le journal. Elles sont déjà comptées par toutes les
+/// statistiques.
+/// \return                 Le nombre de lignes en attente ou en retard.
+std::size_t AnalyseurLogs::getNombreLignesEnAttente() const
+{
+    return lignesEnAttente_.size() + lignesEnRetard_.size();
+}
+
+/// Retourne le nombre de lignes reçues par ajouterLigneLog alors qu'une ligne plus récente était déjà dans le journal,
+/// depuis le dernier chargement. Un nombre qui augmente rapidement indique un retard maximal trop court.
+/// \return                 Le nombre de lignes en retard.
+std::size_t AnalyseurLogs::getNombreLignesEnRetard() const
 {
-	//Insertion de la ligneLog dans le vecteur de logs_
-	std::vector<LigneLog>::iterator it = std::lower_bound(logs_.begin(), logs_.end(), ligneLog, ComparateurLog());
-	logs_.insert(it, ligneLog);
+    return nombreLignesEnRetard_;
+}
 
-	//Incrémenter le nombre de vues du Film de ligneLog	
-	vuesFilms_[ligneLog.film]++;
+/// Active la publication des statistiques à des threads lecteurs et publie l'état actuel. Une fois la publication
+/// activée, le thread qui ajoute les logs publie une nouvelle version après chaque chargement et chaque lot ajouté par
+/// ajouterLignesLog; les lignes ajoutées une à une sont publiées par publierStatistiques.
+void AnalyseurLogs::activerPublication()
+{
+    if (publication_.publication == nullptr)
+    {
+        publication_.publication = std::make_unique<PublicationEpoques<StatistiquesLogs>>();
+        publication_.journalAPublier = true;
+        publierStatistiques();
+    }
 }
 
-/// Retourne le nombre de vues pour un film passé en paramètre
+/// Publie aux lecteurs une nouvelle version des statistiques, si la publication est activée. Les compteurs sont copiés,
+/// mais les lignes de log sont partagées avec la version précédente: les lignes comptées depuis la dernière publication
+/// forment un nouveau segment trié, fusionné aux segments précédents dès qu'il atteint la moitié de la taille de celui
+/// qui le précède. Les segments ont ainsi des tailles qui décroissent géométriquement, une ligne est recopiée O(log n)
+/// fois au total et une requête sur un intervalle ne parcourt que O(log n) segments.
+/// Ne doit être appelée que par le thread qui ajoute les logs.
+void AnalyseurLogs::publierStatistiques()
+{
+    if (publication_.publication == nullptr)
+    {
+        return;
+    }
+
+    auto statistiques = std::make_unique<StatistiquesLogs>();
+    statistiques->films_ = films_;
+    statistiques->utilisateurs_ = utilisateurs_;
+    statistiques->vuesFilms_ = vuesFilms_;
+    statistiques->vuesUtilisateurs_.reserve(vuesUtilisateurs_.size());
+    for (const VuesUtilisateur& vuesUtilisateur : vuesUtilisateurs_)
+    {
+        statistiques->vuesUtilisateurs_.push_back(vuesUtilisateur.nombreVues);
+    }
+    statistiques->classement_ = classementFilms_.getPremiers(films_.size());
+
+    if (publication_.journalAPublier)
+    {
+        // Le journal a été remplacé: il est publié au complet, avec les lignes en attente, en un seul segment
+        auto segment = std::make_shared<JournalLogs>(logs_);
+        publierDans(*segment);
+        statistiques->segments_.push_back(std::move(segment));
+    }
+    else
+    {
+        statistiques->segments_ = publication_.publication->getVersionPubliee().segments_;
+        if (!publication_.lignesNonPubliees.empty())
+        {
+            auto segment = std::make_shared<JournalLogs>();
+            segment->fusionner(std::move(publication_.lignesNonPubliees));
+            statistiques->segments_.push_back(std::move(segment));
+            fusionnerSegments(statistiques->segments_);
+        }
+    }
+    publication_.lignesNonPubliees.clear();
+    publication_.journalAPublier = false;
+    publication_.publication->publier(std::move(statistiques));
+}
+
+/// Crée un lecteur des statistiques publiées, pour un thread qui interroge l'analyseur pendant qu'un autre thread lui
+/// ajoute des logs. Une lecture ne prend aucun verrou et n'attend jamais l'écrivain: elle voit toujours une version
+/// complète et cohérente des statistiques, au pire celle d'avant la dernière publication.
+/// Un lecteur ne doit être utilisé que par un thread à la fois et doit être détruit avant l'analyseur, et les
+/// gestionnaires des logs ne doivent pas être modifiés pendant les lectures.
+/// \return                         Le lecteur, ou std::nullopt si la publication n'est pas activée ou si
+///                                 PublicationEpoques::nombreMaximalLecteurs lecteurs existent déjà.
+std::optional<PublicationEpoques<StatistiquesLogs>::Lecteur> AnalyseurLogs::creerLecteur() const
+{
+    if (publication_.publication == nullptr)
+    {
+        return std::nullopt;
+    }
+    PublicationEpoques<StatistiquesLogs>::Lecteur lecteur(*publication_.publication);
+    if (!lecteur.estValide())
+    {
+        return std::nullopt;
+    }
+    return lecteur;
+}
+
+/// Constructeur par copie. La copie commence sans publication (voir EtatPublication).
+AnalyseurLogs::EtatPublication::EtatPublication(const EtatPublication&)
+{
+}
+
+/// Opérateur d'assignation par copie. La publication est gardée et le journal copié y sera publié au complet.
+/// \return                         Référence à l'état de publication.
+AnalyseurLogs::EtatPublication& AnalyseurLogs::EtatPublication::operator=(const EtatPublication&)
+{
+    lignesNonPubliees.clear();
+    journalAPublier = true;
+    return *this;
+}
+
+/// Constructeur par copie. Les compteurs répartis et les lots transmis sont copiés, mais la copie n'a aucun producteur.
+/// \param other                    L'état à copier.
+AnalyseurLogs::EtatProducteurs::EtatProducteurs(const EtatProducteurs& other)
+{
+    *this = other;
+}
+
+/// Opérateur d'assignation par copie. Aucun producteur de l'analyseur qui reçoit la copie ne doit exister.
+/// \param other                    L'état à copier.
+/// \return                         Référence à l'état des producteurs.
+AnalyseurLogs::EtatProducteurs& AnalyseurLogs::EtatProducteurs::operator=(const EtatProducteurs& other)
+{
+    if (this != &other)
+    {
+        vuesFilms = other.vuesFilms != nullptr ? std::make_unique<CompteursRepartis>(*other.vuesFilms) : nullptr;
+        vuesUtilisateurs = other.vuesUtilisateurs != nullptr
+                               ? std::make_unique<CompteursRepartis>(*other.vuesUtilisateurs)
+                               : nullptr;
+        prochainNumero = other.prochainNumero;
+        std::scoped_lock verrous(mutexLots, other.mutexLots);
+        lotsTransmis = other.lotsTransmis;
+    }
+    return *this;
+}
+
+/// Abandonne les vues comptées et les lots transmis par les producteurs, quand le contenu de l'analyseur est remplacé.
+/// Aucun producteur ne doit exister.
+void AnalyseurLogs::EtatProducteurs::reinitialiser()
+{
+    vuesFilms.reset();
+    vuesUtilisateurs.reset();
+    std::lock_guard<std::mutex> verrou(mutexLots);
+    lotsTransmis.clear();
+}
+
+/// Retourne le nombre de vues pour un film passé en paramètre, y compris les vues comptées par les producteurs qui
+/// n'ont pas encore été intégrées (voir creerProducteur).
 /// \param film                     Film servant à donner le nombre de vues.
 /// \return                         Nombre de vues du film.
 int AnalyseurLogs::getNombreVuesFilm(const Film* film) const
 {
-	auto it = vuesFilms_.find(film);
-	if (it == vuesFilms_.end())
+	IdDense idFilm = getIdFilm(film);
+	if (idFilm == idDenseInvalide)
 	{
 		return 0;
 	}
-	return vuesFilms_.at(film);
+	int nombreVues = vuesFilms_[idFilm];
+	if (producteurs_.vuesFilms != nullptr && idFilm < producteurs_.vuesFilms->getNombreCompteurs())
+	{
+		nombreVues += static_cast<int>(producteurs_.vuesFilms->getTotal(idFilm));
+	}
+	return nombreVues;
 }
 
-/// Retourne le film le plus regardé parmi les données chargées dans l’analyseur de logs. Si les logs sont vides(aucun film n’est trouvé), retourne nullptr
+/// Retourne le film le plus regardé parmi les données chargées dans l’analyseur de logs, en O(1) grâce au classement
+/// maintenu lors de l'ajout des logs, y compris les vues comptées par les producteurs qui n'ont pas encore été
+/// intégrées (voir creerProducteur). Si les logs sont vides (aucun film n’est trouvé), retourne nullptr.
 /// \return                         Le film le plus populaire parmi les données.
 const Film* AnalyseurLogs::getFilmPlusPopulaire() const
 {
-	if (vuesFilms_.empty() == true)
-	{
-		return nullptr;
-	}
-	return std::max_element(vuesFilms_.begin(), vuesFilms_.end(), ComparateurSecondElementPaire<const Film* ,int>())->first;
-
+    IdDense idFilm = classementFilms_.getPremier();
+    if (aVuesProduites())
+    {
+        std::vector<std::pair<IdDense, int>> premier = getPremiersFilms(1);
+        idFilm = premier.empty() ? idDenseInvalide : premier.front().first;
+    }
+    if (idFilm == idDenseInvalide)
+    {
+        return nullptr;
+    }
+    return films_[idFilm];
 }
 
-/// Retourne une liste des films les plus regardés et leur nombre de vues parmi les données chargées dans l'analyseur de logs.
+/// Retourne une liste des films les plus regardés et leur nombre de vues parmi les données chargées dans l'analyseur
+/// de logs, en O(nombre) grâce au classement maintenu lors de l'ajout des logs, y compris les vues comptées par les
+/// producteurs qui n'ont pas encore été intégrées (voir creerProducteur).
 /// \param nombre                   Nombre de films les plus populaires à retourner.
 /// \return                         Liste des films les plus regardés accompagnés de leur nombre de vues.
 std::vector<std::pair<const Film*, int>> AnalyseurLogs::getNFilmsPlusPopulaires(std::size_t nombre) const
 {
-	//std::min(nombre, vuesFilms_.size());
-	std::vector<std::pair<const Film*, int>> vecteurFilmsPopulaires(std::min(nombre, vuesFilms_.size()));
-	std::partial_sort_copy(vuesFilms_.begin(), vuesFilms_.end(), vecteurFilmsPopulaires.begin(), vecteurFilmsPopulaires.end(), 
-		[](const std::pair<const Film*, int>& paire_1, const std::pair<const Film*, int>& paire_2)
-			{ return (paire_1.second > paire_2.second); });
-	return vecteurFilmsPopulaires;
+    std::vector<std::pair<IdDense, int>> premiers = getPremiersFilms(nombre);
+    std::vector<std::pair<const Film*, int>> filmsPopulaires;
+    filmsPopulaires.reserve(premiers.size());
+    for (const auto& [idFilm, nombreVues] : premiers)
+    {
+        filmsPopulaires.emplace_back(films_[idFilm], nombreVues);
+    }
+    return filmsPopulaires;
 }
 
-/// Retourne le nombre de films vus par utilisateur
+/// Retourne le nombre de films vus par utilisateur, en O(1) grâce à l'index des vues par utilisateur, y compris les
+/// vues comptées par les producteurs qui n'ont pas encore été intégrées (voir creerProducteur).
 /// \param utilisateur              Utilisateur pour lequel on veut compter le nombre de vues.
 /// \return                         Nombre de films vus par un utilisateur.
 int AnalyseurLogs::getNombreVuesPourUtilisateur(const Utilisateur* utilisateur) const
 {
-	return static_cast<int>(std::count_if(logs_.begin(), logs_.end(), [&utilisateur](const LigneLog& ligneLog) {return (ligneLog.utilisateur == utilisateur); }));
+    IdDense idUtilisateur = getIdUtilisateur(utilisateur);
+    if (idUtilisateur == idDenseInvalide)
+    {
+        return 0;
+    }
+    int nombreVues = vuesUtilisateurs_[idUtilisateur].nombreVues;
+    if (producteurs_.vuesUtilisateurs != nullptr &&
+        idUtilisateur < producteurs_.vuesUtilisateurs->getNombreCompteurs())
+    {
+        nombreVues += static_cast<int>(producteurs_.vuesUtilisateurs->getTotal(idUtilisateur));
+    }
+    return nombreVues;
 }
 
-/// Retourne un vecteur des films uniques regardés par un utilisateur parmi les données chargées dans l'analyseur de logs.
+/// Retourne un vecteur des films uniques regardés par un utilisateur parmi les données chargées dans l'analyseur de
+/// logs, en temps proportionnel au nombre de films vus par l'utilisateur grâce à l'index des vues par utilisateur.
 /// \param utilisateur              Utilisateur pour lequel on veut compter le nombre de vues.
 /// \return                         Vecteur des films uniques regardés par un utilisateur donné en paramètre.
 std::vector<const Film*> AnalyseurLogs::getFilmsVusParUtilisateur(const Utilisateur* utilisateur) const
 {
-	std::unordered_set<const Film*> set;
-	for (const auto& element : logs_)
-	{
-		if (utilisateur == element.utilisateur)
-		{
-			set.insert(element.film);
-		}
-	}
-	return std::vector<const Film*>(set.begin(), set.end()) ;
+    IdDense idUtilisateur = getIdUtilisateur(utilisateur);
+    if (idUtilisateur == idDenseInvalide)
+    {
+        return std::vector<const Film*>();
+    }
+    const std::unordered_set<IdDense>& filmsVus = vuesUtilisateurs_[idUtilisateur].filmsVus;
+    std::vector<const Film*> films;
+    films.reserve(filmsVus.size());
+    std::transform(filmsVus.begin(), filmsVus.end(), std::back_inserter(films), [this](IdDense idFilm) {
+        return films_[idFilm];
+    });
+    return films;
 }
 
+/// Retourne le nombre de vues d'un film entre deux moments, en ne parcourant avec un noyau vectoriel que la colonne des
+/// films de l'intervalle.
+/// \param film                     Film servant à donner le nombre de vues.
+/// \param debut                    Début de l'intervalle, inclus.
+/// \param fin                      Fin de l'intervalle, incluse.
+/// \return                         Nombre de vues du film dans l'intervalle.
+int AnalyseurLogs::getNombreVuesFilmEntre(const Film* film, Timestamp debut, Timestamp fin) const
+{
+    IdDense idFilm = getIdFilm(film);
+    if (idFilm == idDenseInvalide)
+    {
+        return 0;
+    }
+    auto [debutPlage, finPlage] = logs_.getPlage(debut, fin);
+    auto nombreVues = static_cast<int>(
+        NoyauxComptage::compterEgaux(logs_.getIdsFilms().data() + debutPlage, finPlage - debutPlage, idFilm));
+    pourChaqueLigneNonPubliee(debut, fin, [&](const LigneLog& ligneLog) {
+        nombreVues += ligneLog.idFilm == idFilm ? 1 : 0;
+    });
+    return nombreVues;
+}
 
+/// Retourne une liste des films les plus regardés entre deux moments et leur nombre de vues dans cet intervalle. Les
+/// vues sont comptées dans une structure dont la taille ne dépasse ni celle de l'intervalle ni celle du catalogue: les
+/// identifiants des films d'un intervalle plus court que le catalogue sont copiés et triés, en O(L log L) pour L
+/// lignes, et ceux d'un intervalle plus long sont comptés par un noyau vectoriel dans un tableau indexé par film.
+/// \param nombre                   Nombre de films les plus populaires à retourner.
+/// \param debut                    Début de l'intervalle, inclus.
+/// \param fin                      Fin de l'intervalle, incluse.
+/// \return                         Liste des films les plus regardés dans l'intervalle accompagnés de leur nombre de
+///                                 vues, en ordre décroissant de vues.
+std::vector<std::pair<const Film*, int>> AnalyseurLogs::getNFilmsPlusPopulairesEntre(std::size_t nombre,
+                                                                                      Timestamp debut,
+                                                                                      Timestamp fin) const
+{
+    auto [debutPlage, finPlage] = logs_.getPlage(debut, fin);
+    const IdDense* idsFilmsPlage = logs_.getIdsFilms().data() + debutPlage;
+    std::vector<std::pair<const Film*, int>> filmsVus; // Par identifiant dense croissant, quel que soit le comptage
+    if (finPlage - debutPlage < films_.size())
+    {
+        std::vector<IdDense> idsFilms(idsFilmsPlage, idsFilmsPlage + (finPlage - debutPlage));
+        pourChaqueLigneNonPubliee(debut, fin, [&idsFilms](const LigneLog& ligneLog) {
+            idsFilms.push_back(ligneLog.idFilm);
+        });
+        std::sort(idsFilms.begin(), idsFilms.end());
+        for (auto groupe = idsFilms.begin(); groupe != idsFilms.end();)
+        {
+            auto finGroupe = std::upper_bound(groupe, idsFilms.end(), *groupe);
+            filmsVus.emplace_back(films_[*groupe], static_cast<int>(finGroupe - groupe));
+            groupe = finGroupe;
+        }
+    }
+    else
+    {
+        std::vector<int> vuesFilms(films_.size(), 0);
+        NoyauxComptage::accumulerHistogramme(idsFilmsPlage, finPlage - debutPlage, vuesFilms);
+        pourChaqueLigneNonPubliee(debut, fin, [&vuesFilms](const LigneLog& ligneLog) {
+            vuesFilms[ligneLog.idFilm]++;
+        });
+        for (std::size_t idFilm = 0; idFilm < vuesFilms.size(); idFilm++)
+        {
+            if (vuesFilms[idFilm] > 0)
+            {
+                filmsVus.emplace_back(films_[idFilm], vuesFilms[idFilm]);
+            }
+        }
+    }
+
+    std::vector<std::pair<const Film*, int>> filmsPopulaires(std::min(nombre, filmsVus.size()));
+    std::partial_sort_copy(filmsVus.begin(),
+                           filmsVus.end(),
+                           filmsPopulaires.begin(),
+                           filmsPopulaires.end(),
+                           [](const std::pair<const Film*, int>& paire1, const std::pair<const Film*, int>& paire2) {
+                               return paire1.second > paire2.second;
+                           });
+    return filmsPopulaires;
+}
+
+/// Retourne le nombre de films vus par un utilisateur entre deux moments, en ne parcourant avec un noyau vectoriel que
+/// la colonne des utilisateurs de l'intervalle.
+/// \param utilisateur              Utilisateur pour lequel on veut compter le nombre de vues.
+/// \param debut                    Début de l'intervalle, inclus.
+/// \param fin                      Fin de l'intervalle, incluse.
+/// \return                         Nombre de films vus par l'utilisateur dans l'intervalle.
+int AnalyseurLogs::getNombreVuesPourUtilisateurEntre(const Utilisateur* utilisateur, Timestamp debut,
+                                                     Timestamp fin) const
+{
+    IdDense idUtilisateur = getIdUtilisateur(utilisateur);
+    if (idUtilisateur == idDenseInvalide)
+    {
+        return 0;
+    }
+    auto [debutPlage, finPlage] = logs_.getPlage(debut, fin);
+    auto nombreVues = static_cast<int>(NoyauxComptage::compterEgaux(logs_.getIdsUtilisateurs().data() + debutPlage,
+                                                                    finPlage - debutPlage,
+                                                                    idUtilisateur));
+    pourChaqueLigneNonPubliee(debut, fin, [&](const LigneLog& ligneLog) {
+        nombreVues += ligneLog.idUtilisateur == idUtilisateur ? 1 : 0;
+    });
+    return nombreVues;
+}
@@ -0,0 +1,143 @@
+/// Arène de chaînes de caractères.
+/// \date 2026-10-17
+
+#include "ArenaChaines.h"
+#include <algorithm>
+
+namespace
+{
+    /// Copie des caractères dans un nouveau bloc à leur taille exacte.
+    /// \param chaine   Les caractères à copier, non vides.
+    /// \return         Un pointeur vers les caractères, qui partage le compte de références du bloc.
+    std::shared_ptr<const char> copierDansBloc(std::string_view chaine)
+    {
+        std::shared_ptr<char[]> bloc(new char[chaine.size()]);
+        std::copy(chaine.begin(), chaine.end(), bloc.get());
+        return std::shared_ptr<const char>(bloc, bloc.get());
+    }
+} // namespace
+
+/// Constructeur par copie des caractères d'une chaîne dans un bloc qui n'appartient qu'à la nouvelle chaîne.
+/// \param chaine   La chaîne à copier.
+ChaineArena::ChaineArena(std::string_view chaine)
+    : caracteres_(chaine.empty() ? nullptr : copierDansBloc(chaine))
+    , taille_(chaine.size())
+{
+}
+
+/// Constructeur par copie des caractères d'une chaîne dans un bloc qui n'appartient qu'à la nouvelle chaîne.
+/// \param chaine   La chaîne à copier.
+ChaineArena::ChaineArena(const std::string& chaine)
+    : ChaineArena(std::string_view(chaine))
+{
+}
+
+/// Constructeur par copie des caractères d'une chaîne dans un bloc qui n'appartient qu'à la nouvelle chaîne.
+/// \param chaine   La chaîne à copier, terminée par un caractère nul.
+ChaineArena::ChaineArena(const char* chaine)
+    : ChaineArena(std::string_view(chaine))
+{
+}
+
+/// Constructeur d'une chaîne qui pointe dans un bloc existant.
+/// \param caracteres   Les caractères, qui partagent le compte de références de leur bloc.
+/// \param taille       Le nombre de caractères.
+ChaineArena::ChaineArena(std::shared_ptr<const char> caracteres, std::size_t taille)
+    : caracteres_(std::move(caracteres))
+    , taille_(taille)
+{
+}
+
+/// Retourne une vue sur les caractères, valide tant que cette chaîne ou l'une de ses copies existe.
+/// \return La vue.
+ChaineArena::operator std::string_view() const
+{
+    return std::string_view(caracteres_.get(), taille_);
+}
+
+/// Retourne un pointeur vers les caractères, qui ne sont pas terminés par un caractère nul.
+/// \return Le pointeur, nullptr pour une chaîne vide.
+const char* ChaineArena::data() const
+{
+    return caracteres_.get();
+}
+
+/// Retourne le nombre de caractères.
+/// \return Le nombre de caractères.
+std::size_t ChaineArena::size() const
+{
+    return taille_;
+}
+
+/// Indique si la chaîne est vide.
+/// \return True si la chaîne n'a aucun caractère, false sinon.
+bool ChaineArena::empty() const
+{
+    return taille_ == 0;
+}
+
+/// Compare les caractères de deux chaînes.
+/// \param chaine   La première chaîne.
+/// \param autre    La deuxième chaîne.
+/// \return         True si les chaînes ont les mêmes caractères, false sinon.
+bool operator==(const ChaineArena& chaine, const ChaineArena& autre)
+{
+    return std::string_view(chaine) == std::string_view(autre);
+}
+
+/// Affiche les caractères d'une chaîne à la sortie du stream donné.
+/// \param outputStream Le stream auquel écrire la chaîne.
+/// \param chaine       La chaîne à afficher au stream.
+/// \return             Une référence au stream.
+std::ostream& operator<<(std::ostream& outputStream, const ChaineArena& chaine)
+{
+    return outputStream << std::string_view(chaine);
+}
+
+/// Constructeur.
+/// \param tailleBloc           La taille maximale en octets d'un bloc.
+/// \param taillePremierBloc    La taille en octets du premier bloc.
+ArenaChaines::ArenaChaines(std::size_t tailleBloc, std::size_t taillePremierBloc)
+    : tailleBloc_(std::max<std::size_t>(tailleBloc, 1))
+    , taillePremierBloc_(std::clamp<std::size_t>(taillePremierBloc, 1, tailleBloc_))
+{
+}
+
+/// Copie une chaîne dans l'arène.
+/// \param chaine   La chaîne à copier.
+/// \return         La copie, qui garde son bloc en vie.
+ChaineArena ArenaChaines::ajouter(std::string_view chaine)
+{
+    if (chaine.empty())
+    {
+        return ChaineArena();
+    }
+
+    if (chaine.size() > tailleBloc_ / 4)
+    {
+        nombreBlocs_++;
+        return ChaineArena(copierDansBloc(chaine), chaine.size());
+    }
+    if (tailleDernierBloc_ - positionDernierBloc_ < chaine.size())
+    {
+        std::size_t taille =
+            dernierBloc_ == nullptr ? taillePremierBloc_ : std::min(tailleDernierBloc_ * 2, tailleBloc_);
+        taille = std::max(taille, chaine.size()); // Un premier bloc plus petit que le quart de la taille maximale
+        dernierBloc_.reset(new char[taille]);
+        tailleDernierBloc_ = taille;
+        positionDernierBloc_ = 0;
+        nombreBlocs_++;
+    }
+    char* destination = dernierBloc_.get() + positionDernierBloc_;
+    std::copy(chaine.begin(), chaine.end(), destination);
+    positionDernierBloc_ += chaine.size();
+    return ChaineArena(std::shared_ptr<const char>(dernierBloc_, destination), chaine.size());
+}
+
+/// Retourne le nombre de blocs alloués, en comptant chaque chaîne trop longue pour partager un bloc et les blocs déjà
+/// rendus.
+/// \return Le nombre de blocs.
+std::size_t ArenaChaines::getNombreBlocs() const
+{
+    return nombreBlocs_;
+}
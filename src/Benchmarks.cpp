@@ -0,0 +1,575 @@
+/// Mesures de performance.
+/// \date 2026-10-17
+
+#include "Benchmarks.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "AnalyseurLogs.h"
+#include "CompteursRepartis.h"
+#include "GestionnaireFilms.h"
+#include "GestionnaireUtilisateurs.h"
+#include "LigneLog.h"
+#include "NoyauxComptage.h"
+#include "RedacteurRapport.h"
+
+namespace
+{
+    /// Affiche un header pour chaque benchmark à l'écran.
+    /// \param nomBenchmark Le nom du benchmark.
+    void afficherHeaderBenchmark(const std::string& nomBenchmark)
+    {
+        std::cout << "\nBenchmark " + nomBenchmark + ":\n--------\n";
+    }
+
+    /// Affiche le nom d'une mesure ainsi que sa durée à l'écran.
+    /// \param nom          Le nom de la mesure.
+    /// \param millisecondes La durée mesurée en millisecondes.
+    [[maybe_unused]] void afficherResultatBenchmark(const std::string& nom, double millisecondes)
+    {
+        static constexpr int largeurNomMesure = 50;
+        std::cout << std::left << std::setw(largeurNomMesure) << nom << ": " << std::fixed << std::setprecision(2)
+                  << millisecondes << " ms\n"
+                  << std::defaultfloat;
+    }
+
+    /// Mesure la durée d'exécution d'une fonction.
+    /// \param fonction La fonction à exécuter.
+    /// \return         La durée d'exécution en millisecondes.
+    template<typename Fonction>
+    [[maybe_unused]] double mesurerMillisecondes(Fonction&& fonction)
+    {
+        auto debut = std::chrono::steady_clock::now();
+        fonction();
+        auto fin = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(fin - debut).count();
+    }
+
+    /// Écrit un fichier de logs synthétique en répétant plusieurs fois les lignes d'un fichier de logs existant.
+    /// \param nomFichierSource     Le fichier de logs à répéter.
+    /// \param nomFichierDestination Le fichier à créer.
+    /// \param nombreRepetitions    Le nombre de fois que le fichier source est répété.
+    /// \return                     True si le fichier a pu être écrit, false sinon.
+    [[maybe_unused]] bool ecrireLogsSynthetiques(const std::string& nomFichierSource,
+                                                 const std::string& nomFichierDestination, int nombreRepetitions)
+    {
+        std::ifstream source(nomFichierSource);
+        std::ofstream destination(nomFichierDestination);
+        if (!source || !destination)
+        {
+            return false;
+        }
+        std::string contenu((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+        for (int i = 0; i < nombreRepetitions; i++)
+        {
+            destination << contenu;
+        }
+        return static_cast<bool>(destination);
+    }
+
+    /// Charge un fichier de logs en ajoutant les lignes une à une avec AnalyseurLogs::creerLigneLog, comme le faisait
+    /// AnalyseurLogs::chargerDepuisFichier avant l'ajout par lot. Sert de point de comparaison.
+    /// \param nomFichier               Le fichier à partir duquel lire les logs.
+    /// \param analyseurLogs            L'analyseur dans lequel ajouter les logs.
+    /// \param gestionnaireUtilisateurs Le gestionnaire des utilisateurs pour lier un utilisateur à un log.
+    /// \param gestionnaireFilms        Le gestionnaire des films pour lier un film à un log.
+    [[maybe_unused]] void chargerLigneParLigne(const std::string& nomFichier, AnalyseurLogs& analyseurLogs,
+                                               GestionnaireUtilisateurs& gestionnaireUtilisateurs,
+                                               GestionnaireFilms& gestionnaireFilms)
+    {
+        std::ifstream fichier(nomFichier);
+        std::string ligne;
+        while (std::getline(fichier, ligne))
+        {
+            std::istringstream stream(ligne);
+
+            std::string timestamp;
+            std::string idUtilisateur;
+            std::string nomFilm;
+
+            if (stream >> timestamp >> idUtilisateur >> std::quoted(nomFilm))
+            {
+                analyseurLogs.creerLigneLog(timestamp, idUtilisateur, nomFilm, gestionnaireUtilisateurs,
+                                            gestionnaireFilms);
+            }
+        }
+    }
+} // namespace
+
+namespace Benchmarks
+{
+    /// Appelle tous les benchmarks.
+    void benchAll()
+    {
+        benchChargementLogs();
+        benchNoyauxComptage();
+        benchEnsemblesBits();
+        benchRedacteurRapport();
+        benchInstantanes();
+        benchLignesEnRetard();
+        benchCompteursRepartis();
+    }
+
+    /// Compare le chargement des logs par lot avec l'insertion triée ligne par ligne.
+    void benchChargementLogs()
+    {
+        afficherHeaderBenchmark("chargement des logs");
+
+#if BENCHMARK_CHARGEMENT_LOGS_ACTIF
+        static constexpr int nombreRepetitions = 5;
+
+        GestionnaireUtilisateurs gestionnaireUtilisateurs;
+        gestionnaireUtilisateurs.chargerDepuisFichier("utilisateurs.txt");
+        GestionnaireFilms gestionnaireFilms;
+        gestionnaireFilms.chargerDepuisFichier("films.txt");
+
+        const std::string nomFichier = (std::filesystem::temp_directory_path() / "logs_benchmark.txt").string();
+        if (!ecrireLogsSynthetiques("logs.txt", nomFichier, nombreRepetitions))
+        {
+            std::cerr << "Erreur Benchmarks: le fichier " << nomFichier << " n'a pas pu être écrit\n";
+            return;
+        }
+
+        AnalyseurLogs analyseurLigneParLigne;
+        double dureeLigneParLigne = mesurerMillisecondes([&]() {
+            chargerLigneParLigne(nomFichier, analyseurLigneParLigne, gestionnaireUtilisateurs, gestionnaireFilms);
+        });
+        AnalyseurLogs analyseurParLot;
+        analyseurParLot.setNombreThreads(1);
+        double dureeParLot = mesurerMillisecondes([&]() {
+            analyseurParLot.chargerDepuisFichier(nomFichier, gestionnaireUtilisateurs, gestionnaireFilms);
+        });
+        AnalyseurLogs analyseurParallele;
+        double dureeParallele = mesurerMillisecondes([&]() {
+            analyseurParallele.chargerDepuisFichier(nomFichier, gestionnaireUtilisateurs, gestionnaireFilms);
+        });
+        std::remove(nomFichier.c_str());
+
+        std::cout << "Fichier de " << nombreRepetitions << " x logs.txt\n";
+        afficherResultatBenchmark("Insertion triée ligne par ligne", dureeLigneParLigne);
+        afficherResultatBenchmark("Ajout par lot (1 thread)", dureeParLot);
+        afficherResultatBenchmark("Ajout par lot (" + std::to_string(analyseurParallele.getNombreThreads()) +
+                                      " threads)",
+                                  dureeParallele);
+        std::cout << "Accélération: " << std::setprecision(3) << dureeLigneParLigne / dureeParLot << "x (1 thread), "
+                  << dureeLigneParLigne / dureeParallele << "x (parallèle)\n";
+#else
+        std::cout << "[Benchmark désactivé]\n";
+#endif
+    }
+
+    /// Compare les noyaux de comptage sur une colonne d'identifiants avec std::count_if et une boucle d'histogramme sur
+    /// un vecteur de LigneLog, sur un log synthétique de 100 millions de lignes (environ 2 Go de mémoire).
+    void benchNoyauxComptage()
+    {
+        afficherHeaderBenchmark("noyaux de comptage");
+
+#if BENCHMARK_NOYAUX_COMPTAGE_ACTIF
+        static constexpr std::size_t nombreLignes = 100'000'000;
+        static constexpr IdDense nombreUtilisateurs = 100;
+        static constexpr IdDense nombreFilms = 331;
+        static constexpr IdDense utilisateurRecherche = 42;
+
+        // Générateur congruentiel linéaire, pour que le log soit le même d'une exécution à l'autre
+        std::vector<LigneLog> lignesLog(nombreLignes);
+        std::vector<IdDense> idsUtilisateurs(nombreLignes);
+        std::vector<IdDense> idsFilms(nombreLignes);
+        std::uint64_t etat = 1;
+        for (std::size_t i = 0; i < nombreLignes; i++)
+        {
+            etat = etat * 6364136223846793005ULL + 1442695040888963407ULL;
+            auto aleatoire = static_cast<IdDense>(etat >> 32);
+            idsUtilisateurs[i] = aleatoire % nombreUtilisateurs;
+            idsFilms[i] = aleatoire / nombreUtilisateurs % nombreFilms;
+            lignesLog[i] = LigneLog{static_cast<Timestamp>(i), idsUtilisateurs[i], idsFilms[i]};
+        }
+        std::cout << "Log synthétique de " << nombreLignes << " lignes\n";
+
+        std::ptrdiff_t nombreAttendu = 0;
+        double dureeCountIf = mesurerMillisecondes([&]() {
+            nombreAttendu = std::count_if(lignesLog.begin(), lignesLog.end(), [](const LigneLog& ligneLog) {
+                return ligneLog.idUtilisateur == utilisateurRecherche;
+            });
+        });
+        afficherResultatBenchmark("std::count_if sur vector<LigneLog>", dureeCountIf);
+        for (NoyauxComptage::Implementation implementation : {NoyauxComptage::Implementation::Scalaire,
+                                                              NoyauxComptage::Implementation::Sse2,
+                                                              NoyauxComptage::Implementation::Avx2})
+        {
+            if (!NoyauxComptage::estSupportee(implementation))
+            {
+                continue;
+            }
+            std::size_t nombre = 0;
+            double duree = mesurerMillisecondes([&]() {
+                nombre = NoyauxComptage::compterEgaux(idsUtilisateurs.data(),
+                                                      idsUtilisateurs.size(),
+                                                      utilisateurRecherche,
+                                                      implementation);
+            });
+            afficherResultatBenchmark(std::string("compterEgaux sur colonne (") +
+                                          NoyauxComptage::getNomImplementation(implementation) + ")",
+                                      duree);
+            if (nombre != static_cast<std::size_t>(nombreAttendu))
+            {
+                std::cerr << "Erreur Benchmarks: compterEgaux a donné " << nombre << " au lieu de " << nombreAttendu
+                          << '\n';
+            }
+        }
+
+        std::vector<int> vuesFilmsBoucle(nombreFilms, 0);
+        double dureeBoucle = mesurerMillisecondes([&]() {
+            for (const LigneLog& ligneLog : lignesLog)
+            {
+                vuesFilmsBoucle[ligneLog.idFilm]++;
+            }
+        });
+        afficherResultatBenchmark("Histogramme sur vector<LigneLog>", dureeBoucle);
+        std::vector<int> vuesFilmsNoyau(nombreFilms, 0);
+        double dureeNoyau = mesurerMillisecondes(
+            [&]() { NoyauxComptage::accumulerHistogramme(idsFilms.data(), idsFilms.size(), vuesFilmsNoyau); });
+        afficherResultatBenchmark("accumulerHistogramme sur colonne", dureeNoyau);
+        if (vuesFilmsNoyau != vuesFilmsBoucle)
+        {
+            std::cerr << "Erreur Benchmarks: les histogrammes sont différents\n";
+        }
+#else
+        std::cout << "[Benchmark désactivé]\n";
+#endif
+    }
+
+    /// Compare les ensembles de bits par genre et par pays avec l'union et l'intersection des copies retournées par
+    /// getFilmsParGenre et getFilmsParPays, sur un catalogue synthétique de 200 000 films.
+    void benchEnsemblesBits()
+    {
+        afficherHeaderBenchmark("ensembles de bits");
+
+#if BENCHMARK_ENSEMBLES_BITS_ACTIF
+        static constexpr int nombreFilms = 200'000;
+        static constexpr int nombreRepetitions = 100;
+        const std::vector<Film::Genre> genres = {Film::Genre::Drame, Film::Genre::Comedie, Film::Genre::Horreur};
+        const std::vector<Pays> pays = {Pays::France, Pays::Canada};
+
+        // Générateur congruentiel linéaire, pour que le catalogue soit le même d'une exécution à l'autre
+        GestionnaireFilms gestionnaireFilms;
+        std::uint64_t etat = 1;
+        for (int i = 0; i < nombreFilms; i++)
+        {
+            etat = etat * 6364136223846793005ULL + 1442695040888963407ULL;
+            auto aleatoire = static_cast<int>(etat >> 33);
+            gestionnaireFilms.ajouterFilm(Film{"Film" + std::to_string(i),
+                                               static_cast<Film::Genre>(aleatoire % 9),
+                                               static_cast<Pays>(aleatoire / 9 % 9),
+                                               "Réalisateur",
+                                               1900 + aleatoire / 81 % 120});
+        }
+        std::cout << "Catalogue synthétique de " << nombreFilms << " films, " << genres.size() << " genres et "
+                  << pays.size() << " pays, " << nombreRepetitions << " requêtes\n";
+
+        std::size_t nombreVecteurs = 0;
+        double dureeVecteurs = mesurerMillisecondes([&]() {
+            for (int repetition = 0; repetition < nombreRepetitions; repetition++)
+            {
+                std::vector<const Film*> filmsGenres;
+                for (Film::Genre genre : genres)
+                {
+                    std::vector<const Film*> filmsGenre = gestionnaireFilms.getFilmsParGenre(genre);
+                    filmsGenres.insert(filmsGenres.end(), filmsGenre.begin(), filmsGenre.end());
+                }
+                std::vector<const Film*> filmsPays;
+                for (Pays unPays : pays)
+                {
+                    std::vector<const Film*> filmsUnPays = gestionnaireFilms.getFilmsParPays(unPays);
+                    filmsPays.insert(filmsPays.end(), filmsUnPays.begin(), filmsUnPays.end());
+                }
+                std::sort(filmsGenres.begin(), filmsGenres.end());
+                std::sort(filmsPays.begin(), filmsPays.end());
+                std::vector<const Film*> intersection;
+                std::set_intersection(filmsGenres.begin(),
+                                      filmsGenres.end(),
+                                      filmsPays.begin(),
+                                      filmsPays.end(),
+                                      std::back_inserter(intersection));
+                nombreVecteurs = intersection.size();
+            }
+        });
+        afficherResultatBenchmark("Copies de vecteurs et set_intersection", dureeVecteurs);
+
+        std::size_t nombreBits = 0;
+        double dureeCompte = mesurerMillisecondes([&]() {
+            for (int repetition = 0; repetition < nombreRepetitions; repetition++)
+            {
+                nombreBits = gestionnaireFilms.compterFilmsParGenresEtPays(genres, pays);
+            }
+        });
+        afficherResultatBenchmark("compterFilmsParGenresEtPays", dureeCompte);
+
+        std::size_t nombreFilmsBits = 0;
+        double dureeListe = mesurerMillisecondes([&]() {
+            for (int repetition = 0; repetition < nombreRepetitions; repetition++)
+            {
+                nombreFilmsBits = gestionnaireFilms.getFilmsParGenresEtPays(genres, pays).size();
+            }
+        });
+        afficherResultatBenchmark("getFilmsParGenresEtPays", dureeListe);
+
+        if (nombreBits != nombreVecteurs || nombreFilmsBits != nombreVecteurs)
+        {
+            std::cerr << "Erreur Benchmarks: les ensembles de bits ont donné " << nombreBits << " films au lieu de "
+                      << nombreVecteurs << '\n';
+        }
+        std::cout << "Accélération: " << std::setprecision(3) << dureeVecteurs / dureeCompte << "x (compte), "
+                  << dureeVecteurs / dureeListe << "x (liste)\n";
+#else
+        std::cout << "[Benchmark désactivé]\n";
+#endif
+    }
+
+    /// Compare l'écriture du catalogue par RedacteurRapport avec l'écriture film par film dans un std::ofstream, sur un
+    /// catalogue synthétique de 500 000 films.
+    void benchRedacteurRapport()
+    {
+        afficherHeaderBenchmark("rédacteur de rapports");
+
+#if BENCHMARK_REDACTEUR_RAPPORT_ACTIF
+        static constexpr int nombreFilms = 500'000;
+
+        GestionnaireFilms gestionnaireFilms;
+        for (int i = 0; i < nombreFilms; i++)
+        {
+            gestionnaireFilms.ajouterFilm(Film{"Film" + std::to_string(i),
+                                               static_cast<Film::Genre>(i % nombreGenres),
+                                               static_cast<Pays>(i / 7 % nombrePays),
+                                               "Réalisateur " + std::to_string(i % 1000),
+                                               1900 + i % 120});
+        }
+        std::cout << "Catalogue synthétique de " << nombreFilms << " films\n";
+
+        const std::string nomFichier = (std::filesystem::temp_directory_path() / "rapport_benchmark.txt").string();
+        double dureeStream = mesurerMillisecondes([&]() {
+            std::ofstream fichier(nomFichier);
+            fichier << "Le gestionnaire de films contient " << gestionnaireFilms.getNombreFilms() << " films.\n"
+                    << "Affichage par catégories:\n";
+            for (std::size_t i = 0; i < nombreGenres; i++)
+            {
+                auto genre = static_cast<Film::Genre>(i);
+                std::vector<const Film*> films = gestionnaireFilms.getFilmsParGenre(genre);
+                fichier << "Genre: " << getGenreString(genre) << " (" << films.size() << " films):\n";
+                for (const Film* film : films)
+                {
+                    fichier << '\t' << *film << std::endl;
+                }
+            }
+        });
+        afficherResultatBenchmark("operator<< film par film avec std::endl", dureeStream);
+
+        for (RedacteurRapport::Format format :
+             {RedacteurRapport::Format::Texte, RedacteurRapport::Format::Csv, RedacteurRapport::Format::Json})
+        {
+            double duree = mesurerMillisecondes([&]() {
+                std::ofstream fichier;
+                fichier.rdbuf()->pubsetbuf(nullptr, 0); // Un appel système par tampon plein du rédacteur
+                fichier.open(nomFichier);
+                RedacteurRapport redacteur(fichier, format);
+                redacteur.ecrireFilms(gestionnaireFilms);
+            });
+            static const char* nomsFormats[] = {"texte", "CSV", "JSON"};
+            afficherResultatBenchmark(std::string("RedacteurRapport (") + nomsFormats[static_cast<int>(format)] + ")",
+                                      duree);
+        }
+        std::remove(nomFichier.c_str());
+#else
+        std::cout << "[Benchmark désactivé]\n";
+#endif
+    }
+
+    /// Compare le chargement des fichiers texte avec le chargement des instantanés binaires des mêmes données.
+    void benchInstantanes()
+    {
+        afficherHeaderBenchmark("instantanés binaires");
+
+#if BENCHMARK_INSTANTANES_ACTIF
+        static constexpr int nombreRepetitions = 50;
+
+        const std::filesystem::path dossier = std::filesystem::temp_directory_path();
+        const std::string nomFichierLogs = (dossier / "logs_benchmark.txt").string();
+        const std::string nomInstantaneUtilisateurs = (dossier / "utilisateurs_benchmark.instantane").string();
+        const std::string nomInstantaneFilms = (dossier / "films_benchmark.instantane").string();
+        const std::string nomInstantaneLogs = (dossier / "logs_benchmark.instantane").string();
+        if (!ecrireLogsSynthetiques("logs.txt", nomFichierLogs, nombreRepetitions))
+        {
+            std::cerr << "Erreur Benchmarks: le fichier " << nomFichierLogs << " n'a pas pu être écrit\n";
+            return;
+        }
+
+        GestionnaireUtilisateurs gestionnaireUtilisateursTexte;
+        GestionnaireFilms gestionnaireFilmsTexte;
+        AnalyseurLogs analyseurLogsTexte;
+        double dureeTexte = mesurerMillisecondes([&]() {
+            gestionnaireUtilisateursTexte.chargerDepuisFichier("utilisateurs.txt");
+            gestionnaireFilmsTexte.chargerDepuisFichier("films.txt");
+            analyseurLogsTexte.chargerDepuisFichier(nomFichierLogs, gestionnaireUtilisateursTexte,
+                                                    gestionnaireFilmsTexte);
+        });
+        double dureeSauvegarde = mesurerMillisecondes([&]() {
+            gestionnaireUtilisateursTexte.sauvegarderInstantane(nomInstantaneUtilisateurs);
+            gestionnaireFilmsTexte.sauvegarderInstantane(nomInstantaneFilms);
+            analyseurLogsTexte.sauvegarderInstantane(nomInstantaneLogs);
+        });
+
+        GestionnaireUtilisateurs gestionnaireUtilisateursInstantane;
+        GestionnaireFilms gestionnaireFilmsInstantane;
+        AnalyseurLogs analyseurLogsInstantane;
+        double dureeInstantane = mesurerMillisecondes([&]() {
+            gestionnaireUtilisateursInstantane.chargerInstantane(nomInstantaneUtilisateurs);
+            gestionnaireFilmsInstantane.chargerInstantane(nomInstantaneFilms);
+            analyseurLogsInstantane.chargerInstantane(nomInstantaneLogs, gestionnaireUtilisateursInstantane,
+                                                      gestionnaireFilmsInstantane);
+        });
+        std::remove(nomFichierLogs.c_str());
+        std::remove(nomInstantaneUtilisateurs.c_str());
+        std::remove(nomInstantaneFilms.c_str());
+        std::remove(nomInstantaneLogs.c_str());
+
+        std::cout << "Utilisateurs, films et fichier de " << nombreRepetitions << " x logs.txt\n";
+        afficherResultatBenchmark("Chargement des fichiers texte", dureeTexte);
+        afficherResultatBenchmark("Sauvegarde des instantanés", dureeSauvegarde);
+        afficherResultatBenchmark("Chargement des instantanés", dureeInstantane);
+        std::cout << "Accélération: " << std::setprecision(3) << dureeTexte / dureeInstantane << "x\n";
+#else
+        std::cout << "[Benchmark désactivé]\n";
+#endif
+    }
+
+    /// Compare l'ajout ligne par ligne d'un flux de logs légèrement désordonné avec et sans retard maximal: sans
+    /// retard, chaque ligne arrivée après une ligne plus récente décale toutes les lignes qui la suivent dans le
+    /// journal.
+    void benchLignesEnRetard()
+    {
+        afficherHeaderBenchmark("lignes en retard");
+
+#if BENCHMARK_LIGNES_EN_RETARD_ACTIF
+        static constexpr std::size_t nombreLignes = 1'000'000;
+        static constexpr Timestamp retardMaximal = 900;
+
+        GestionnaireUtilisateurs gestionnaireUtilisateurs;
+        gestionnaireUtilisateurs.chargerDepuisFichier("utilisateurs.txt");
+        GestionnaireFilms gestionnaireFilms;
+        gestionnaireFilms.chargerDepuisFichier("films.txt");
+        auto nombreUtilisateurs = static_cast<IdDense>(gestionnaireUtilisateurs.getNombreIdsDenses());
+        auto nombreFilms = static_cast<IdDense>(gestionnaireFilms.getNombreIdsDenses());
+
+        // Une ligne toutes les 10 secondes, reçue avec jusqu'à 10 minutes de retard, et 1 ligne sur 100 reçue jusqu'à
+        // une semaine en retard
+        std::vector<LigneLog> lignesLog(nombreLignes);
+        std::uint64_t etat = 1;
+        for (std::size_t i = 0; i < nombreLignes; i++)
+        {
+            etat = etat * 6364136223846793005ULL + 1442695040888963407ULL;
+            auto aleatoire = static_cast<IdDense>(etat >> 32);
+            Timestamp retard = static_cast<Timestamp>(aleatoire % 100 == 0 ? aleatoire % 604800 : aleatoire % 600);
+            lignesLog[i] = LigneLog{static_cast<Timestamp>(i) * 10 - retard,
+                                    aleatoire % nombreUtilisateurs,
+                                    aleatoire / nombreUtilisateurs % nombreFilms};
+        }
+        std::cout << "Flux synthétique de " << nombreLignes << " lignes\n";
+
+        for (Timestamp retard : {Timestamp{0}, retardMaximal})
+        {
+            AnalyseurLogs analyseurLogs;
+            analyseurLogs.setRetardMaximal(retard);
+            double duree = mesurerMillisecondes([&]() {
+                for (const LigneLog& ligneLog : lignesLog)
+                {
+                    analyseurLogs.ajouterLigneLog(ligneLog, gestionnaireUtilisateurs, gestionnaireFilms);
+                }
+                analyseurLogs.publierLignesEnAttente();
+            });
+            afficherResultatBenchmark("Retard maximal de " + std::to_string(retard) + " s", duree);
+            std::cout << "Lignes en retard: " << analyseurLogs.getNombreLignesEnRetard() << '\n';
+        }
+#else
+        std::cout << "[Benchmark désactivé]\n";
+#endif
+    }
+
+    /// Compare le comptage des vues par plusieurs threads dans des compteurs répartis avec un unordered_map protégé par
+    /// un verrou, de 1 thread à au moins 8 threads.
+    void benchCompteursRepartis()
+    {
+        afficherHeaderBenchmark("compteurs répartis");
+
+#if BENCHMARK_COMPTEURS_REPARTIS_ACTIF
+        static constexpr std::size_t nombreIncrements = 8'000'000;
+        static constexpr std::size_t nombreFilms = 10'000;
+
+        // Chaque thread compte sa part des incréments, sur des films tirés au hasard
+        auto compterEnParallele = [](unsigned int nombreThreads, auto&& incrementer) {
+            std::vector<std::thread> threads;
+            for (unsigned int producteur = 0; producteur < nombreThreads; producteur++)
+            {
+                threads.emplace_back([&incrementer, nombreThreads, producteur]() {
+                    std::uint64_t etat = producteur + 1;
+                    for (std::size_t i = 0; i < nombreIncrements / nombreThreads; i++)
+                    {
+                        etat = etat * 6364136223846793005ULL + 1442695040888963407ULL;
+                        incrementer(static_cast<std::size_t>(etat >> 32) % nombreFilms, producteur);
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        };
+
+        unsigned int nombreThreadsMaximal = std::max(8U, std::thread::hardware_concurrency());
+        std::cout << nombreIncrements << " incréments sur " << nombreFilms << " films, "
+                  << std::thread::hardware_concurrency() << " coeurs\n";
+        for (unsigned int nombreThreads = 1; nombreThreads <= nombreThreadsMaximal; nombreThreads *= 2)
+        {
+            std::mutex mutex;
+            std::unordered_map<IdDense, int> vuesVerrou;
+            double dureeVerrou = mesurerMillisecondes([&]() {
+                compterEnParallele(nombreThreads, [&](std::size_t idFilm, unsigned int) {
+                    std::lock_guard<std::mutex> verrou(mutex);
+                    vuesVerrou[static_cast<IdDense>(idFilm)]++;
+                });
+            });
+
+            CompteursRepartis vuesRepartis(nombreFilms, nombreThreads);
+            std::vector<std::int64_t> vuesRepliees(nombreFilms);
+            double dureeRepartis = mesurerMillisecondes([&]() {
+                compterEnParallele(nombreThreads, [&](std::size_t idFilm, unsigned int producteur) {
+                    vuesRepartis.incrementer(idFilm, producteur);
+                });
+                for (std::size_t idFilm = 0; idFilm < nombreFilms; idFilm++)
+                {
+                    vuesRepliees[idFilm] = vuesRepartis.getTotal(idFilm);
+                }
+            });
+
+            bool totauxIdentiques = std::all_of(vuesVerrou.begin(), vuesVerrou.end(), [&](const auto& vues) {
+                return vuesRepliees[vues.first] == vues.second;
+            });
+            std::string suffixe = " (" + std::to_string(nombreThreads) + " threads)";
+            afficherResultatBenchmark("unordered_map et verrou" + suffixe, dureeVerrou);
+            afficherResultatBenchmark("CompteursRepartis et lecture" + suffixe, dureeRepartis);
+            std::cout << "Totaux identiques: " << (totauxIdentiques ? "oui" : "non") << '\n';
+        }
+#else
+        std::cout << "[Benchmark désactivé]\n";
+#endif
+    }
+} // namespace Benchmarks
@@ -0,0 +1,106 @@
+/// Classement des films par nombre de vues.
+/// \date 2026-10-17
+
+#include "ClassementFilms.h"
+#include <algorithm>
+
+/// Ajoute une vue à un film, en O(1) amorti. Un film absent du classement y est ajouté avec une vue.
+/// \param idFilm   L'identifiant dense du film qui a été vu.
+void ClassementFilms::incrementer(IdDense idFilm)
+{
+    if (idFilm >= positions_.size())
+    {
+        positions_.resize(idFilm + std::size_t{1}, positionInvalide);
+    }
+    if (positions_[idFilm] == positionInvalide)
+    {
+        positions_[idFilm] = films_.size();
+        films_.emplace_back(idFilm, 0);
+        debutsGroupes_.try_emplace(0, films_.size() - 1);
+    }
+
+    // Échanger le film avec le premier film de son groupe, qui passe ensuite au groupe précédent
+    std::size_t position = positions_[idFilm];
+    int nombreVues = films_[position].second;
+    std::size_t debutGroupe = debutsGroupes_[nombreVues];
+    if (position != debutGroupe)
+    {
+        std::swap(films_[position], films_[debutGroupe]);
+        positions_[films_[position].first] = position;
+        positions_[idFilm] = debutGroupe;
+    }
+    films_[debutGroupe].second++;
+
+    if (debutGroupe + 1 < films_.size() && films_[debutGroupe + 1].second == nombreVues)
+    {
+        debutsGroupes_[nombreVues] = debutGroupe + 1;
+    }
+    else
+    {
+        debutsGroupes_.erase(nombreVues);
+    }
+    debutsGroupes_.try_emplace(nombreVues + 1, debutGroupe);
+}
+
+/// Reconstruit tout le classement à partir du nombre de vues de chaque film, après un chargement par lot. Les films
+/// ayant le même nombre de vues sont classés par identifiant dense.
+/// \param vuesFilms    Le nombre de vues de chaque film, indexé par identifiant dense. Les films sans vue sont ignorés.
+void ClassementFilms::reconstruire(const std::vector<int>& vuesFilms)
+{
+    vider();
+    for (std::size_t idFilm = 0; idFilm < vuesFilms.size(); idFilm++)
+    {
+        if (vuesFilms[idFilm] > 0)
+        {
+            films_.emplace_back(static_cast<IdDense>(idFilm), vuesFilms[idFilm]);
+        }
+    }
+    std::stable_sort(films_.begin(),
+                     films_.end(),
+                     [](const std::pair<IdDense, int>& paire1, const std::pair<IdDense, int>& paire2) {
+                         return paire1.second > paire2.second;
+                     });
+
+    positions_.assign(vuesFilms.size(), positionInvalide);
+    for (std::size_t i = 0; i < films_.size(); i++)
+    {
+        positions_[films_[i].first] = i;
+        debutsGroupes_.try_emplace(films_[i].second, i);
+    }
+}
+
+/// Retire tous les films du classement.
+void ClassementFilms::vider()
+{
+    films_.clear();
+    positions_.clear();
+    debutsGroupes_.clear();
+}
+
+/// Indique si le classement est vide.
+/// \return True si aucun film n'a de vue, false sinon.
+bool ClassementFilms::estVide() const
+{
+    return films_.empty();
+}
+
+/// Retourne le film ayant le plus de vues, en O(1).
+/// \return L'identifiant dense du film le plus populaire, ou idDenseInvalide si le classement est vide.
+IdDense ClassementFilms::getPremier() const
+{
+    if (films_.empty())
+    {
+        return idDenseInvalide;
+    }
+    return films_.front().first;
+}
+
+/// Retourne les films ayant le plus de vues, en O(nombre).
+/// \param nombre   Le nombre de films à retourner.
+/// \return         Les identifiants denses des films les plus populaires avec leur nombre de vues, en ordre
+///                 décroissant de vues.
+std::vector<std::pair<IdDense, int>> ClassementFilms::getPremiers(std::size_t nombre) const
+{
+    auto fin = std::next(films_.begin(), static_cast<std::ptrdiff_t>(std::min(nombre, films_.size())));
+    return std::vector<std::pair<IdDense, int>>(films_.begin(), fin);
+}
@@ -0,0 +1,91 @@
+/// Compteurs répartis entre plusieurs threads producteurs.
+/// \date 2026-10-17
+
+#include "CompteursRepartis.h"
+#include <algorithm>
+
+/// Constructeur. Tous les compteurs commencent à 0.
+/// \param nombreCompteurs      Le nombre de compteurs.
+/// \param nombreFragments      Le nombre de fragments, habituellement le nombre de threads producteurs (au plus
+///                             nombreMaximalFragments).
+CompteursRepartis::CompteursRepartis(std::size_t nombreCompteurs, std::size_t nombreFragments)
+    : nombreCompteurs_(nombreCompteurs)
+    , nombreFragments_(std::clamp<std::size_t>(nombreFragments, 1, nombreMaximalFragments))
+    , lignesParFragment_((nombreCompteurs + compteursParLigne - 1) / compteursParLigne)
+    , lignes_(nombreFragments_ * lignesParFragment_)
+{
+}
+
+/// Constructeur par copie. Aucun producteur ne doit modifier les compteurs copiés pendant la copie.
+/// \param other                Les compteurs à copier.
+CompteursRepartis::CompteursRepartis(const CompteursRepartis& other)
+    : nombreCompteurs_(other.nombreCompteurs_)
+    , nombreFragments_(other.nombreFragments_)
+    , lignesParFragment_(other.lignesParFragment_)
+    , lignes_(other.lignes_.size())
+{
+    for (std::size_t ligne = 0; ligne < lignes_.size(); ligne++)
+    {
+        for (std::size_t i = 0; i < compteursParLigne; i++)
+        {
+            lignes_[ligne].compteurs[i].store(other.lignes_[ligne].compteurs[i].load(std::memory_order_relaxed),
+                                              std::memory_order_relaxed);
+        }
+    }
+}
+
+/// Incrémente un compteur dans le fragment d'un producteur. Peut être appelée par plusieurs threads en même temps.
+/// \param index                L'index du compteur, inférieur au nombre de compteurs.
+/// \param producteur           Le numéro du producteur qui appelle.
+void CompteursRepartis::incrementer(std::size_t index, std::size_t producteur)
+{
+    getCompteur(index, producteur).fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Décrémente un compteur dans le fragment d'un producteur, par exemple quand une vue qu'il a comptée est reportée
+/// ailleurs. Peut être appelée par plusieurs threads en même temps.
+/// \param index                L'index du compteur, inférieur au nombre de compteurs.
+/// \param producteur           Le numéro du producteur qui avait incrémenté le compteur.
+void CompteursRepartis::decrementer(std::size_t index, std::size_t producteur)
+{
+    getCompteur(index, producteur).fetch_sub(1, std::memory_order_relaxed);
+}
+
+/// Retourne le nombre de compteurs.
+/// \return                     Le nombre de compteurs.
+std::size_t CompteursRepartis::getNombreCompteurs() const
+{
+    return nombreCompteurs_;
+}
+
+/// Retourne le nombre de fragments, et donc le nombre d'additions d'une lecture.
+/// \return                     Le nombre de fragments.
+std::size_t CompteursRepartis::getNombreFragments() const
+{
+    return nombreFragments_;
+}
+
+/// Retourne la valeur d'un compteur en O(nombre de fragments). Pendant que des producteurs incrémentent, la valeur
+/// compte au moins tous les incréments terminés avant l'appel qui sont visibles au thread qui lit.
+/// \param index                L'index du compteur.
+/// \return                     La somme du compteur dans tous les fragments.
+std::int64_t CompteursRepartis::getTotal(std::size_t index) const
+{
+    std::int64_t total = 0;
+    for (std::size_t fragment = 0; fragment < nombreFragments_; fragment++)
+    {
+        std::size_t ligne = fragment * lignesParFragment_ + index / compteursParLigne;
+        total += lignes_[ligne].compteurs[index % compteursParLigne].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/// Retourne un compteur dans le fragment d'un producteur.
+/// \param index                L'index du compteur.
+/// \param producteur           Le numéro du producteur.
+/// \return                     Le compteur.
+std::atomic<std::int32_t>& CompteursRepartis::getCompteur(std::size_t index, std::size_t producteur)
+{
+    std::size_t ligne = producteur % nombreFragments_ * lignesParFragment_ + index / compteursParLigne;
+    return lignes_[ligne].compteurs[index % compteursParLigne];
+}
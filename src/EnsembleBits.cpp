@@ -0,0 +1,99 @@
+/// Ensemble d'identifiants denses sous forme de bits.
+/// \date 2026-10-17
+
+#include "EnsembleBits.h"
+#include <algorithm>
+
+namespace
+{
+    /// Compte les bits à 1 d'un mot.
+    /// \param mot  Le mot.
+    /// \return     Le nombre de bits à 1.
+    std::size_t compterBits(std::uint64_t mot)
+    {
+#ifdef _MSC_VER
+        return static_cast<std::size_t>(__popcnt64(mot));
+#else
+        return static_cast<std::size_t>(__builtin_popcountll(mot));
+#endif
+    }
+} // namespace
+
+/// Ajoute un identifiant à l'ensemble, en agrandissant l'ensemble au besoin.
+/// \param id   L'identifiant à ajouter.
+void EnsembleBits::ajouter(IdDense id)
+{
+    std::size_t indexMot = id / bitsParMot;
+    if (indexMot >= mots_.size())
+    {
+        mots_.resize(indexMot + 1, 0);
+    }
+    mots_[indexMot] |= std::uint64_t{1} << (id % bitsParMot);
+}
+
+/// Retire un identifiant de l'ensemble.
+/// \param id   L'identifiant à retirer.
+void EnsembleBits::retirer(IdDense id)
+{
+    std::size_t indexMot = id / bitsParMot;
+    if (indexMot < mots_.size())
+    {
+        mots_[indexMot] &= ~(std::uint64_t{1} << (id % bitsParMot));
+    }
+}
+
+/// Vérifie si un identifiant est dans l'ensemble.
+/// \param id   L'identifiant.
+/// \return     True si l'identifiant est dans l'ensemble, false sinon.
+bool EnsembleBits::contient(IdDense id) const
+{
+    std::size_t indexMot = id / bitsParMot;
+    return indexMot < mots_.size() && (mots_[indexMot] >> (id % bitsParMot) & 1) != 0;
+}
+
+/// Retourne le nombre d'identifiants de l'ensemble.
+/// \return Le nombre d'identifiants.
+std::size_t EnsembleBits::compter() const
+{
+    std::size_t nombre = 0;
+    for (std::uint64_t mot : mots_)
+    {
+        nombre += compterBits(mot);
+    }
+    return nombre;
+}
+
+/// Retire tous les identifiants de l'ensemble.
+void EnsembleBits::vider()
+{
+    mots_.clear();
+}
+
+/// Ajoute à l'ensemble tous les identifiants d'un autre ensemble (union).
+/// \param other    L'autre ensemble.
+/// \return         Référence à l'ensemble actuel.
+EnsembleBits& EnsembleBits::operator|=(const EnsembleBits& other)
+{
+    if (other.mots_.size() > mots_.size())
+    {
+        mots_.resize(other.mots_.size(), 0);
+    }
+    for (std::size_t i = 0; i < other.mots_.size(); i++)
+    {
+        mots_[i] |= other.mots_[i];
+    }
+    return *this;
+}
+
+/// Ne garde dans l'ensemble que les identifiants aussi présents dans un autre ensemble (intersection).
+/// \param other    L'autre ensemble.
+/// \return         Référence à l'ensemble actuel.
+EnsembleBits& EnsembleBits::operator&=(const EnsembleBits& other)
+{
+    mots_.resize(std::min(mots_.size(), other.mots_.size()));
+    for (std::size_t i = 0; i < mots_.size(); i++)
+    {
+        mots_[i] &= other.mots_[i];
+    }
+    return *this;
+}
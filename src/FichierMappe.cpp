@@ -0,0 +1,134 @@
+/// Fichier projeté en mémoire en lecture seule.
+/// \date 2026-10-17
+
+#include "FichierMappe.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// Constructeur qui projette le fichier en mémoire. Un fichier vide est considéré ouvert avec un contenu vide.
+/// \param nomFichier   Le fichier à projeter.
+FichierMappe::FichierMappe(const std::string& nomFichier)
+{
+#ifdef _WIN32
+    HANDLE fichier = CreateFileA(nomFichier.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fichier == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    LARGE_INTEGER taille;
+    if (GetFileSizeEx(fichier, &taille))
+    {
+        taille_ = static_cast<std::size_t>(taille.QuadPart);
+        if (taille_ == 0)
+        {
+            estOuvert_ = true;
+        }
+        else if (HANDLE projection = CreateFileMappingA(fichier, nullptr, PAGE_READONLY, 0, 0, nullptr))
+        {
+            donnees_ = static_cast<const char*>(MapViewOfFile(projection, FILE_MAP_READ, 0, 0, 0));
+            estOuvert_ = donnees_ != nullptr;
+            CloseHandle(projection);
+        }
+    }
+    CloseHandle(fichier);
+#else
+    int descripteur = open(nomFichier.c_str(), O_RDONLY);
+    if (descripteur == -1)
+    {
+        return;
+    }
+    struct stat informations;
+    if (fstat(descripteur, &informations) == 0)
+    {
+        taille_ = static_cast<std::size_t>(informations.st_size);
+        if (taille_ == 0)
+        {
+            estOuvert_ = true;
+        }
+        else
+        {
+            void* projection = mmap(nullptr, taille_, PROT_READ, MAP_PRIVATE, descripteur, 0);
+            if (projection != MAP_FAILED)
+            {
+                madvise(projection, taille_, MADV_SEQUENTIAL);
+                donnees_ = static_cast<const char*>(projection);
+                estOuvert_ = true;
+            }
+        }
+    }
+    close(descripteur);
+#endif
+    if (!estOuvert_)
+    {
+        taille_ = 0;
+    }
+}
+
+/// Constructeur par déplacement.
+/// \param other    Le fichier projeté dont la projection est transférée.
+FichierMappe::FichierMappe(FichierMappe&& other) noexcept
+    : donnees_(std::exchange(other.donnees_, nullptr))
+    , taille_(std::exchange(other.taille_, 0))
+    , estOuvert_(std::exchange(other.estOuvert_, false))
+{
+}
+
+/// Opérateur d'assignation par déplacement.
+/// \param other    Le fichier projeté dont la projection est transférée.
+/// \return         Référence à l'objet actuel.
+FichierMappe& FichierMappe::operator=(FichierMappe&& other) noexcept
+{
+    if (this != &other)
+    {
+        fermer();
+        donnees_ = std::exchange(other.donnees_, nullptr);
+        taille_ = std::exchange(other.taille_, 0);
+        estOuvert_ = std::exchange(other.estOuvert_, false);
+    }
+    return *this;
+}
+
+/// Destructeur qui libère la projection.
+FichierMappe::~FichierMappe()
+{
+    fermer();
+}
+
+/// Indique si le fichier a pu être ouvert et projeté.
+/// \return True si le fichier est projeté, false sinon.
+bool FichierMappe::estOuvert() const
+{
+    return estOuvert_;
+}
+
+/// Retourne le contenu du fichier.
+/// \return Une vue sur le contenu complet du fichier, valide tant que l'objet existe.
+std::string_view FichierMappe::getContenu() const
+{
+    return std::string_view(donnees_, taille_);
+}
+
+/// Libère la projection, s'il y en a une.
+void FichierMappe::fermer()
+{
+    if (donnees_ != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(donnees_);
+#else
+        munmap(const_cast<char*>(donnees_), taille_);
+#endif
+    }
+    donnees_ = nullptr;
+    taille_ = 0;
+    estOuvert_ = false;
+}
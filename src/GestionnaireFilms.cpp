@@ -6,62 +6,134 @@
 
 #include "GestionnaireFilms.h"
 #include <algorithm>
-#include <fstream>
-#include <iomanip>
+#include <atomic>
+#include <climits>
+#include <functional>
 #include <iostream>
-#include <sstream>
-#include "Foncteurs.h"
-#include "RawPointerBackInserter.h"
+#include <iterator>
+#include "FichierMappe.h"
+#include "Instantane.h"
+#include "LecteurChamps.h"
+#include "RedacteurRapport.h"
 
-/// Constructeur par copie.
-/// \param other    Le gestionnaire de films à partir duquel copier la classe.
-GestionnaireFilms::GestionnaireFilms(const GestionnaireFilms& other)
+namespace
 {
-    films_.reserve(other.films_.size());
-    filtreNomFilms_.reserve(other.filtreNomFilms_.size());
-    filtreGenreFilms_.reserve(other.filtreGenreFilms_.size());
-    filtrePaysFilms_.reserve(other.filtrePaysFilms_.size());
+    /// Enregistrement de taille fixe d'un film dans un instantané.
+    struct EnregistrementFilm
+    {
+        ReferenceChaine nom;
+        ReferenceChaine realisateur;
+        std::int32_t annee;
+        std::uint8_t genre;
+        std::uint8_t pays;
+        std::uint8_t estSupprime;
+        std::uint8_t reserve;
+    };
+
+    /// Indique si une partie de l'état d'un gestionnaire est partagée avec un instantané. La barrière garantit que les
+    /// lectures d'un instantané détruit par un autre thread sont terminées avant que la partie soit modifiée en place.
+    /// \param partie       La partie de l'état.
+    /// \return             True si un autre gestionnaire possède aussi la partie, false sinon.
+    template<typename T>
+    bool estPartagee(const std::shared_ptr<T>& partie)
+    {
+        bool partagee = partie.use_count() != 1;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return partagee;
+    }
+
+    /// Retourne une partie de l'état d'un gestionnaire pour la modifier, après l'avoir copiée si un instantané la
+    /// partage encore. Seule cette partie est copiée: les parties qu'elle contient restent partagées.
+    /// \param partie       La partie de l'état.
+    /// \return             La partie, dont le gestionnaire est maintenant le seul propriétaire.
+    template<typename T>
+    T& modifier(std::shared_ptr<T>& partie)
+    {
+        if (estPartagee(partie))
+        {
+            partie = std::make_shared<T>(*partie);
+        }
+        return *partie;
+    }
+
+    /// Retourne une catégorie d'un filtre pour la modifier, en la créant au besoin.
+    /// \param filtre       Le filtre par genre ou par pays.
+    /// \param cle          Le genre ou le pays de la catégorie.
+    /// \return             La catégorie, dont le gestionnaire est le seul propriétaire.
+    template<typename Cle, typename Categorie>
+    Categorie& modifierCategorie(std::unordered_map<Cle, std::shared_ptr<Categorie>>& filtre, Cle cle)
+    {
+        std::shared_ptr<Categorie>& categorie = filtre[cle];
+        if (categorie == nullptr)
+        {
+            categorie = std::make_shared<Categorie>();
+        }
+        return modifier(categorie);
+    }
+} // namespace
 
-    for (const auto& film : other.films_)
+/// Constructeur de l'état d'un gestionnaire vide.
+GestionnaireFilms::EtatFilms::EtatFilms()
+    : stockage(std::make_shared<StockageFilms>())
+    , films(std::make_shared<std::vector<Film*>>())
+    , filmsParIdDense(std::make_shared<std::vector<const Film*>>())
+    , emplacements(std::make_shared<std::vector<EmplacementFilm>>())
+    , filmsParAnnee(std::make_shared<std::vector<const Film*>>())
+{
+    for (std::shared_ptr<SeauNoms>& seau : filtreNomFilms)
+    {
+        seau = std::make_shared<SeauNoms>();
+    }
+    for (std::shared_ptr<EnsembleBits>& bitsGenre : bitsGenres)
+    {
+        bitsGenre = std::make_shared<EnsembleBits>();
+    }
+    for (std::shared_ptr<EnsembleBits>& bitsPays : bitsPays)
     {
-        // TODO: Uncomment une fois que la fonction ajouterFilm est écrite
-         ajouterFilm(*film);
+        bitsPays = std::make_shared<EnsembleBits>();
     }
 }
 
-/// Opérateur d'assignation par copie utilisant le copy-and-swap idiom.
+/// Constructeur d'un gestionnaire vide qui interne ses réalisateurs dans une table partagée, par exemple avec un
+/// gestionnaire d'utilisateurs.
+/// \param poolChaines  La table de chaînes, ou nullptr pour que le gestionnaire crée la sienne.
+GestionnaireFilms::GestionnaireFilms(std::shared_ptr<PoolChaines> poolChaines)
+    : poolChaines_(std::move(poolChaines))
+{
+}
+
+/// Constructeur par copie, en O(1): la copie partage l'état de l'original, que le premier des deux à être modifié
+/// copie en partie (voir modifierEtat). Cette première modification coûte O(n), puisqu'elle copie au complet la liste
+/// des films, le répertoire des identifiants denses, les emplacements et l'index par année; les suivantes retrouvent
+/// leur coût habituel jusqu'au prochain instantané. La copie a les mêmes films et les mêmes identifiants denses que
+/// l'original, et partage sa table de chaînes.
+/// \param other    Le gestionnaire de films à partir duquel copier la classe.
+GestionnaireFilms::GestionnaireFilms(const GestionnaireFilms& other)
+    : etat_(other.etat_)
+    , poolChaines_(other.poolChaines_)
+{
+}
+
+/// Opérateur d'assignation par copie, en O(1) comme le constructeur par copie, avec le même coût en O(n) à la première
+/// modification de l'un ou l'autre des gestionnaires.
 /// \param other    Le gestionnaire de films à partir duquel copier la classe.
 /// \return         Référence à l'objet actuel.
-GestionnaireFilms& GestionnaireFilms::operator=(GestionnaireFilms other)
+GestionnaireFilms& GestionnaireFilms::operator=(const GestionnaireFilms& other)
 {
-    std::swap(films_, other.films_);
-    std::swap(filtreNomFilms_, other.filtreNomFilms_);
-    std::swap(filtreGenreFilms_, other.filtreGenreFilms_);
-    std::swap(filtrePaysFilms_, other.filtrePaysFilms_);
+    etat_ = other.etat_;
+    poolChaines_ = other.poolChaines_;
     return *this;
 }
 
 /// Affiche les informations des films gérés par le gestionnaire de films à la sortie du stream donné.
+/// Le texte est formaté par RedacteurRapport dans un tampon plutôt que champ par champ dans le stream.
 /// \param outputStream         Le stream auquel écrire les informations des films.
 /// \param gestionnaireFilms    Le gestionnaire de films à afficher au stream.
 /// \return                     Une référence au stream.
 std::ostream& operator<<(std::ostream& outputStream, const GestionnaireFilms& gestionnaireFilms)
 {
-    // TODO: Uncomment une fois que la fonction getNombreFilms est écrite
-    outputStream << "Le gestionnaire de films contient " << gestionnaireFilms.getNombreFilms() << " films.\n"
-                 << "Affichage par catégories:\n";
-
-    // TODO: Réécrire l'implémentation avec des range-based for et structured bindings (voir énoncé du TP)
-	for (const auto& [key, value] : gestionnaireFilms.filtreGenreFilms_)
-	{
-		Film::Genre genre = key;
-		std::vector<const Film*> listeFilms = value;
-		outputStream << "Genre: " << getGenreString(genre) << " (" << listeFilms.size() << " films):\n";
-		for (const auto& element : listeFilms)
-		{
-			outputStream << '\t' << *element << '\n';
-		}
-	}
+    RedacteurRapport redacteur(outputStream, RedacteurRapport::Format::Texte);
+    redacteur.ecrireFilms(gestionnaireFilms);
     return outputStream;
 }
 
@@ -70,31 +142,37 @@ std::ostream& operator<<(std::ostream& outputStream, const GestionnaireFilms& ge
 /// \return             True si tout le chargement s'est effectué avec succès, false sinon.
 bool GestionnaireFilms::chargerDepuisFichier(const std::string& nomFichier)
 {
-    std::ifstream fichier(nomFichier);
-    if (fichier)
+    FichierMappe fichier(nomFichier);
+    if (fichier.estOuvert())
     {
-        films_.clear();
-        filtreNomFilms_.clear();
-        filtreGenreFilms_.clear();
-        filtrePaysFilms_.clear();
+        vider();
 
         bool succesParsing = true;
 
-        std::string ligne;
-        while (std::getline(fichier, ligne))
+        std::string tamponNom;
+        std::string tamponRealisateur;
+        Film film{}; // Caractéristiques de la ligne, dont les chaînes sont copiées directement dans l'arène
+        LecteurLignes lecteurLignes(fichier.getContenu());
+        std::string_view ligne;
+        while (lecteurLignes.lireLigne(ligne))
         {
-            std::istringstream stream(ligne);
+            LecteurChamps lecteurChamps(ligne);
 
-            std::string nom;
+            std::string_view nom;
             int genre;
             int pays;
-            std::string realisateur;
+            std::string_view realisateur;
             int annee;
 
-            if (stream >> std::quoted(nom) >> genre >> pays >> std::quoted(realisateur) >> annee)
+            if (lecteurChamps.lireChaine(nom, tamponNom) && lecteurChamps.lireEntier(genre) &&
+                lecteurChamps.lireEntier(pays) && lecteurChamps.lireChaine(realisateur, tamponRealisateur) &&
+                lecteurChamps.lireEntier(annee) && estGenreValide(static_cast<Film::Genre>(genre)) &&
+                estPaysValide(static_cast<Pays>(pays)))
             {
-                // TODO: Uncomment une fois que la fonction ajouterFilm est écrite
-                 ajouterFilm(Film{nom, static_cast<Film::Genre>(genre), static_cast<Pays>(pays), realisateur, annee});
+                film.genre = static_cast<Film::Genre>(genre);
+                film.pays = static_cast<Pays>(pays);
+                film.annee = annee;
+                ajouterFilm(film, nom, realisateur);
             }
             else
             {
@@ -109,99 +187,553 @@ bool GestionnaireFilms::chargerDepuisFichier(const std::string& nomFichier)
     return false;
 }
 
-/// Ajoute un film au gestionnaire et met à jour les filtres en conséquence.
+/// Ajoute un film au gestionnaire et met à jour les filtres en conséquence. L'insertion dans l'index par année ne
+/// décale rien lorsque les films sont ajoutés en ordre d'année.
 /// \param film         Le film à ajouter.
 /// \return             True si le film a été ajouté avec succès, 
-//						False si le film n’a pas pu être ajouté puisque son nom était déjà présent dans le filtre par nom (il ne peut y avoir qu’un film avec le même nom à la fois).
+//						False si le film n’a pas pu être ajouté puisque son nom était déjà présent dans le filtre par nom (il ne peut y avoir qu’un film avec le même nom à la fois)
+//						ou puisque son genre ou son pays n'est pas une valeur de l'enum.
 bool GestionnaireFilms::ajouterFilm(const Film& film)
 {
-	if (getFilmParNom(film.nom) != nullptr)
+	return ajouterFilm(film, film.nom, film.realisateur);
+}
+
+/// Ajoute un film dont le nom et le réalisateur sont donnés à part, pour les copier dans l'arène sans passer par une
+/// copie intermédiaire.
+/// \param film         Le film à ajouter, dont le nom et le réalisateur sont ignorés.
+/// \param nom          Le nom du film.
+/// \param realisateur  Le réalisateur du film.
+/// \return             True si le film a été ajouté, false si son nom est déjà présent ou si son genre ou son pays
+///                     n'est pas une valeur de l'enum.
+bool GestionnaireFilms::ajouterFilm(const Film& film, std::string_view nom, std::string_view realisateur)
+{
+	if (!estGenreValide(film.genre) || !estPaysValide(film.pays) || getFilmParNom(nom) != nullptr)
 	{
 		return false;
 	}
-	films_.push_back(std::move(std::make_unique<Film>(film)));
-	filtreNomFilms_.emplace(film.nom, films_.back().get());
-	filtreGenreFilms_[film.genre].push_back(films_.back().get());
-	filtrePaysFilms_[film.pays].push_back(films_.back().get());
+	const Film* nouveauFilm = creerFilm(film, nom, realisateur);
+
+	// Le nouveau film a le plus grand identifiant dense: il va après tous les films de la même année
+	std::vector<const Film*>& filmsParAnnee = modifier(modifierEtat().filmsParAnnee);
+	auto positionAnnee = std::upper_bound(filmsParAnnee.begin(), filmsParAnnee.end(), nouveauFilm->annee,
+	                                      [](int annee, const Film* autre) { return annee < autre->annee; });
+	filmsParAnnee.insert(positionAnnee, nouveauFilm);
 	return true;
 }
 
-/// Supprime un film du gestionnaire à partir de son nom.
+/// Renumérote les films restants de 0 à n - 1, dans l'ordre de leurs anciens identifiants denses, pour que les
+/// tableaux indexés par identifiant ne gardent plus de place pour les films supprimés. Les films sont recopiés dans un
+/// nouveau stockage: les pointeurs obtenus avant la compaction ne sont plus valides, sauf dans les instantanés pris
+/// avant, qui gardent les anciens films. L'ordre des films dans les catégories et dans l'index par année est conservé.
+/// \return             Le nouvel identifiant de chaque ancien identifiant, idDenseInvalide pour un film supprimé.
+std::vector<IdDense> GestionnaireFilms::compacterIdsDenses()
+{
+    const EtatFilms& ancien = getEtat();
+    std::vector<IdDense> nouveauxIds(ancien.filmsParIdDense->size(), idDenseInvalide);
+    getPoolChaines();
+    GestionnaireFilms compacte(poolChaines_); // Les réalisateurs internés sont retrouvés sans être copiés
+    for (const Film* film : *ancien.filmsParIdDense)
+    {
+        if (film != nullptr)
+        {
+            nouveauxIds[film->idDense] = compacte.creerFilm(*film, film->nom, film->realisateur)->idDense;
+        }
+    }
+
+    EtatFilms& etat = compacte.modifierEtat();
+    std::vector<Film*> filmsParNouvelId = *etat.films;
+    std::vector<Film*>& films = *etat.films;
+    std::vector<EmplacementFilm>& emplacements = *etat.emplacements;
+    for (std::size_t position = 0; position < films.size(); position++)
+    {
+        films[position] = filmsParNouvelId[nouveauxIds[(*ancien.films)[position]->idDense]];
+        emplacements[films[position]->idDense].positionFilms = position;
+    }
+    std::vector<const Film*>& filmsParAnnee = *etat.filmsParAnnee;
+    filmsParAnnee.reserve(films.size());
+    for (const Film* film : *ancien.filmsParAnnee)
+    {
+        filmsParAnnee.push_back(filmsParNouvelId[nouveauxIds[film->idDense]]);
+    }
+
+    *this = std::move(compacte);
+    return nouveauxIds;
+}
+
+/// Sauvegarde les films dans un instantané binaire, que chargerInstantane recharge sans interpréter de texte. Chaque
+/// identifiant dense, y compris celui d'un film supprimé, a un enregistrement de taille fixe qui désigne le nom et le
+/// réalisateur dans le bloc de chaînes; l'index par année est sauvegardé déjà trié.
+/// \param nomFichier   Le fichier de l'instantané.
+/// \return             True si l'instantané a été écrit avec succès, false sinon.
+bool GestionnaireFilms::sauvegarderInstantane(const std::string& nomFichier) const
+{
+    const std::vector<const Film*>& filmsParIdDense = *getEtat().filmsParIdDense;
+    const std::vector<const Film*>& filmsParAnnee = *getEtat().filmsParAnnee;
+    BlocChaines chaines;
+    std::vector<EnregistrementFilm> enregistrements(filmsParIdDense.size());
+    for (std::size_t idDense = 0; idDense < filmsParIdDense.size(); idDense++)
+    {
+        const Film* film = filmsParIdDense[idDense];
+        EnregistrementFilm& enregistrement = enregistrements[idDense];
+        if (film == nullptr)
+        {
+            enregistrement.estSupprime = 1;
+            continue;
+        }
+        enregistrement.nom = chaines.ajouter(film->nom);
+        enregistrement.realisateur = chaines.ajouter(film->realisateur);
+        enregistrement.annee = film->annee;
+        enregistrement.genre = static_cast<std::uint8_t>(film->genre);
+        enregistrement.pays = static_cast<std::uint8_t>(film->pays);
+    }
+    std::vector<IdDense> idsParAnnee;
+    idsParAnnee.reserve(filmsParAnnee.size());
+    for (const Film* film : filmsParAnnee)
+    {
+        idsParAnnee.push_back(film->idDense);
+    }
+
+    EcrivainInstantane ecrivain(ContenuInstantane::Films);
+    ecrivain.ajouterSection(enregistrements);
+    ecrivain.ajouterSection(chaines.getDonnees());
+    ecrivain.ajouterSection(idsParAnnee);
+    if (!chaines.estValide() || !ecrivain.ecrire(nomFichier))
+    {
+        std::cerr << "Erreur GestionnaireFilms: l'instantané " << nomFichier << " n'a pas pu être écrit\n";
+        return false;
+    }
+    return true;
+}
+
+/// Remplace les films du gestionnaire par ceux d'un instantané écrit par sauvegarderInstantane. Les films reçoivent les
+/// mêmes identifiants denses qu'au moment de la sauvegarde, ce qui garde valides les logs qui y font référence, et
+/// l'index par année est repris tel quel plutôt que trié de nouveau.
+/// \param nomFichier   Le fichier de l'instantané.
+/// \return             True si l'instantané a été chargé avec succès, false sinon (le gestionnaire est alors vide).
+bool GestionnaireFilms::chargerInstantane(const std::string& nomFichier)
+{
+    LecteurInstantane lecteur(nomFichier, ContenuInstantane::Films);
+    std::vector<EnregistrementFilm> enregistrements;
+    std::vector<IdDense> idsParAnnee;
+    vider();
+    bool succesChargement = lecteur.estValide() && lecteur.getNombreSections() == 3 &&
+                            lecteur.lireSection(0, enregistrements) && lecteur.lireSection(2, idsParAnnee);
+
+    std::string_view chaines = succesChargement ? lecteur.getSection(1) : std::string_view();
+    EtatFilms& etat = modifierEtat();
+    std::vector<const Film*>& filmsParIdDense = modifier(etat.filmsParIdDense);
+    std::vector<EmplacementFilm>& emplacements = modifier(etat.emplacements);
+    filmsParIdDense.reserve(enregistrements.size());
+    emplacements.reserve(enregistrements.size());
+    for (std::shared_ptr<SeauNoms>& seau : etat.filtreNomFilms)
+    {
+        modifier(seau).reserve(enregistrements.size() / nombreSeauxNoms + 1);
+    }
+    Film filmLu{};
+    for (std::size_t i = 0; succesChargement && i < enregistrements.size(); i++)
+    {
+        const EnregistrementFilm& enregistrement = enregistrements[i];
+        if (enregistrement.estSupprime != 0)
+        {
+            filmsParIdDense.push_back(nullptr);
+            emplacements.push_back(EmplacementFilm{});
+            continue;
+        }
+        std::string_view nom;
+        std::string_view realisateur;
+        succesChargement = BlocChaines::lireChaine(chaines, enregistrement.nom, nom) &&
+                           BlocChaines::lireChaine(chaines, enregistrement.realisateur, realisateur) &&
+                           enregistrement.genre < nombreGenres && enregistrement.pays < nombrePays &&
+                           getFilmParNom(nom) == nullptr;
+        if (succesChargement)
+        {
+            filmLu.genre = static_cast<Film::Genre>(enregistrement.genre);
+            filmLu.pays = static_cast<Pays>(enregistrement.pays);
+            filmLu.annee = enregistrement.annee;
+            creerFilm(filmLu, nom, realisateur);
+        }
+    }
+
+    // L'index par année doit contenir chaque film une fois, trié par année puis par identifiant dense
+    std::vector<const Film*>& filmsParAnnee = modifier(etat.filmsParAnnee);
+    succesChargement = succesChargement && idsParAnnee.size() == etat.films->size();
+    filmsParAnnee.reserve(idsParAnnee.size());
+    for (std::size_t i = 0; succesChargement && i < idsParAnnee.size(); i++)
+    {
+        const Film* film = getFilmParIdDense(idsParAnnee[i]);
+        const Film* precedent = filmsParAnnee.empty() ? nullptr : filmsParAnnee.back();
+        succesChargement = film != nullptr &&
+                           (precedent == nullptr || precedent->annee < film->annee ||
+                            (precedent->annee == film->annee && precedent->idDense < film->idDense));
+        filmsParAnnee.push_back(film);
+    }
+
+    if (!succesChargement)
+    {
+        vider();
+        std::cerr << "Erreur GestionnaireFilms: l'instantané " << nomFichier << " n'a pas pu être chargé\n";
+    }
+    return succesChargement;
+}
+
+/// Retire tous les films du gestionnaire, ainsi que leurs identifiants denses. Les instantanés gardent leurs films.
+void GestionnaireFilms::vider()
+{
+    etat_.reset();
+}
+
+/// Construit une copie d'un film dans le stockage des films, lui donne le prochain identifiant dense et l'ajoute à tous
+/// les filtres sauf l'index par année. Le nom est copié dans l'arène du segment actuel et le réalisateur est interné
+/// dans la table de chaînes; le filtre par nom a pour clé une vue sur le nom de la copie.
+/// \param film         Le film à copier, dont le nom et le réalisateur sont ignorés.
+/// \param nom          Le nom du film, qui n'est pas déjà dans le gestionnaire.
+/// \param realisateur  Le réalisateur du film.
+/// \return             Le film construit.
+const Film* GestionnaireFilms::creerFilm(const Film& film, std::string_view nom, std::string_view realisateur)
+{
+    EtatFilms& etat = modifierEtat();
+    StockageFilms& stockage = preparerStockage(etat);
+    Film* nouveauFilm = stockage.poolFilms.creer(Film{stockage.chainesFilms.ajouter(nom), film.genre, film.pays,
+                                                      getPoolChaines().interner(realisateur), film.annee});
+
+    std::vector<Film*>& films = modifier(etat.films);
+    std::vector<const Film*>& filmsParIdDense = modifier(etat.filmsParIdDense);
+    nouveauFilm->idDense = static_cast<IdDense>(filmsParIdDense.size());
+    films.push_back(nouveauFilm);
+    filmsParIdDense.push_back(nouveauFilm);
+    modifier(etat.filtreNomFilms[getSeauNom(nouveauFilm->nom)]).emplace(nouveauFilm->nom, nouveauFilm);
+    std::vector<const Film*>& filmsGenre = modifierCategorie(etat.filtreGenreFilms, film.genre).films;
+    std::vector<const Film*>& filmsPays = modifierCategorie(etat.filtrePaysFilms, film.pays).films;
+    modifier(etat.emplacements).push_back(EmplacementFilm{films.size() - 1, filmsGenre.size(), filmsPays.size()});
+    filmsGenre.push_back(nouveauFilm);
+    filmsPays.push_back(nouveauFilm);
+    modifier(etat.bitsGenres[static_cast<std::size_t>(film.genre)]).ajouter(nouveauFilm->idDense);
+    modifier(etat.bitsPays[static_cast<std::size_t>(film.pays)]).ajouter(nouveauFilm->idDense);
+    return nouveauFilm;
+}
+
+/// Rend l'emplacement d'un film supprimé au stockage, à moins qu'un instantané puisse encore le lire: le film est
+/// alors gardé jusqu'à ce que son segment ne soit plus partagé (voir preparerStockage).
+/// \param film         Le film, déjà retiré de tous les filtres.
+void GestionnaireFilms::libererFilm(Film* film)
+{
+    EtatFilms& etat = modifierEtat();
+    StockageFilms& stockage = preparerStockage(etat);
+    if (stockage.poolFilms.contient(film))
+    {
+        stockage.poolFilms.liberer(film);
+    }
+    else
+    {
+        etat.filmsALiberer.push_back(film);
+    }
+}
+
+/// Retourne le segment actuel du stockage pour le modifier. Un segment partagé avec un instantané n'est jamais modifié:
+/// un nouveau segment vide est alors ajouté, qui n'alloue ses films qu'à la première création. Sinon, les segments
+/// précédents qu'aucun instantané ne partage plus sont absorbés par le segment actuel sans déplacer leurs films, puis
+/// les emplacements des films supprimés qui y attendaient sont rendus au stockage. Chaque segment n'est absorbé
+/// qu'une fois, et les films supprimés ne sont parcourus qu'après une absorption.
+/// \param etat         L'état du gestionnaire, dont le gestionnaire est le seul propriétaire.
+/// \return             Le segment actuel, qu'aucun instantané ne partage.
+GestionnaireFilms::StockageFilms& GestionnaireFilms::preparerStockage(EtatFilms& etat)
+{
+    if (estPartagee(etat.stockage))
+    {
+        auto segment = std::make_shared<StockageFilms>();
+        segment->precedent = std::move(etat.stockage);
+        etat.stockage = std::move(segment);
+        return *etat.stockage;
+    }
+
+    StockageFilms& stockage = *etat.stockage;
+    bool segmentAbsorbe = false;
+    while (stockage.precedent != nullptr && !estPartagee(stockage.precedent))
+    {
+        std::shared_ptr<StockageFilms> precedent = std::move(stockage.precedent);
+        stockage.poolFilms.absorber(std::move(precedent->poolFilms));
+        stockage.precedent = std::move(precedent->precedent);
+        segmentAbsorbe = true;
+    }
+    if (segmentAbsorbe)
+    {
+        // Un film supprimé n'attend jamais dans le segment actuel: il y est libéré dès sa suppression
+        std::vector<Film*>& filmsALiberer = etat.filmsALiberer;
+        auto finALiberer = std::remove_if(filmsALiberer.begin(), filmsALiberer.end(), [&stockage](Film* film) {
+            if (!stockage.poolFilms.contient(film))
+            {
+                return false;
+            }
+            stockage.poolFilms.liberer(film);
+            return true;
+        });
+        filmsALiberer.erase(finALiberer, filmsALiberer.end());
+    }
+    return stockage;
+}
+
+/// Retourne la table de chaînes du gestionnaire, en la créant si elle n'existe pas encore.
+/// \return             La table de chaînes.
+PoolChaines& GestionnaireFilms::getPoolChaines()
+{
+    if (poolChaines_ == nullptr)
+    {
+        poolChaines_ = std::make_shared<PoolChaines>();
+    }
+    return *poolChaines_;
+}
+
+/// Supprime un film du gestionnaire à partir de son nom, en O(1) amorti. Le film est trouvé par le filtre par nom,
+/// puis remplacé dans la liste des films par le dernier film et retiré de ses catégories grâce à son emplacement.
 /// \param nomFilm      Le nom du film à supprimer.
 /// \return             True si le film a été trouvé et supprimé avec succès, 
 //						False si le film n’a pas pu être supprimé puisqu’aucun film avec le nom donné n’a pu être trouvé.
-bool GestionnaireFilms::supprimerFilm(const std::string& nomFilm)
-{
-	//TODO: trouver itérateur vers film de nom donné
-	//		TODO: utiliser méthode de la STL avec fonction lambda pour cela
-				//TODO: fonction lambda: cherche le unique_ptr de Film à partir du string donné en paramètre
-	std::vector<std::unique_ptr<Film>>::iterator iteratorTrouve = find_if(films_.begin(), films_.end()
-		, [&nomFilm](std::unique_ptr<Film>& film)
-		{ return (film->nom == nomFilm); });
-
-	//TODO: Tester valeur film , vérifier si le film existe dans le vecteur
-	//	Si oui, déréferencer l'itérateur pour obtenir le film
-	//	Si non, retourner false????
-	if (iteratorTrouve == films_.end())
-	{
-		return false;
-	}
-	Film filmTrouve = *(iteratorTrouve->get());
+bool GestionnaireFilms::supprimerFilm(std::string_view nomFilm)
+{
+    const Film* film = getFilmParNom(nomFilm);
+    if (film == nullptr)
+    {
+        return false;
+    }
+    EtatFilms& etat = modifierEtat();
+    std::size_t position = (*etat.emplacements)[film->idDense].positionFilms;
+    retirerDesFiltres(*film, true);
+
+    // Remplacer le film par le dernier pour ne pas décaler les films suivants
+    std::vector<Film*>& films = modifier(etat.films);
+    if (position != films.size() - 1)
+    {
+        std::swap(films[position], films.back());
+        modifier(etat.emplacements)[films[position]->idDense].positionFilms = position;
+    }
+    libererFilm(films.back());
+    films.pop_back();
+    return true;
+}
+
+/// Supprime plusieurs films du gestionnaire en un seul passage sur la liste des films, sur les catégories et sur
+/// l'index par année, plutôt qu'un passage par film. L'ordre des films restants est conservé.
+/// \param nomsFilms    Les noms des films à supprimer.
+/// \return             Le nombre de films trouvés et supprimés.
+std::size_t GestionnaireFilms::supprimerFilms(const std::vector<std::string_view>& nomsFilms)
+{
+    std::vector<Film*> filmsSupprimes;
+    for (std::string_view nomFilm : nomsFilms)
+    {
+        const Film* film = getFilmParNom(nomFilm);
+        if (film != nullptr)
+        {
+            EtatFilms& etat = modifierEtat();
+            std::size_t position = (*etat.emplacements)[film->idDense].positionFilms;
+            retirerDesFiltres(*film, false);
+            std::vector<Film*>& films = modifier(etat.films);
+            filmsSupprimes.push_back(films[position]);
+            films[position] = nullptr;
+        }
+    }
+    if (filmsSupprimes.empty())
+    {
+        return 0;
+    }
+
+    EtatFilms& etat = modifierEtat();
+    std::vector<Film*>& films = modifier(etat.films);
+    std::vector<EmplacementFilm>& emplacements = modifier(etat.emplacements);
+    films.erase(std::remove(films.begin(), films.end(), nullptr), films.end());
+    for (std::size_t position = 0; position < films.size(); position++)
+    {
+        emplacements[films[position]->idDense].positionFilms = position;
+    }
+    // Seules les catégories qui ont perdu un film sont copiées si elles sont partagées
+    for (auto& [genre, categorie] : etat.filtreGenreFilms)
+    {
+        if (categorie->nombreRetires != 0)
+        {
+            compacterCategorie(modifier(categorie), &EmplacementFilm::positionGenre);
+        }
+    }
+    for (auto& [pays, categorie] : etat.filtrePaysFilms)
+    {
+        if (categorie->nombreRetires != 0)
+        {
+            compacterCategorie(modifier(categorie), &EmplacementFilm::positionPays);
+        }
+    }
+    const std::vector<const Film*>& filmsParIdDense = *etat.filmsParIdDense;
+    auto estSupprime = [&filmsParIdDense](const Film* film) { return filmsParIdDense[film->idDense] == nullptr; };
+    std::vector<const Film*>& filmsParAnnee = modifier(etat.filmsParAnnee);
+    filmsParAnnee.erase(std::remove_if(filmsParAnnee.begin(), filmsParAnnee.end(), estSupprime),
+                        filmsParAnnee.end());
+
+    for (Film* film : filmsSupprimes)
+    {
+        libererFilm(film);
+    }
+    return filmsSupprimes.size();
+}
 
-	//TODO: Suppression dans filtreNomFilms_: Utiliser une méthode de suppression par clé
-	filtreNomFilms_.erase(nomFilm);
+/// Retire un film du filtre par nom, du répertoire des identifiants denses, des catégories et des ensembles de bits de
+/// son genre et de son pays et de l'index par année. Le film lui-même reste dans la liste des films.
+/// \param film                 Le film à retirer.
+/// \param compacterCategories  True pour compacter les catégories devenues à moitié vides et retirer le film de
+///                             l'index par année, false pour laisser l'appelant compacter les catégories et l'index.
+void GestionnaireFilms::retirerDesFiltres(const Film& film, bool compacterCategories)
+{
+    EtatFilms& etat = modifierEtat();
+    EmplacementFilm emplacement = (*etat.emplacements)[film.idDense];
+    CategorieFilms& categorieGenre = modifierCategorie(etat.filtreGenreFilms, film.genre);
+    categorieGenre.films[emplacement.positionGenre] = nullptr;
+    categorieGenre.nombreRetires++;
+    CategorieFilms& categoriePays = modifierCategorie(etat.filtrePaysFilms, film.pays);
+    categoriePays.films[emplacement.positionPays] = nullptr;
+    categoriePays.nombreRetires++;
+    modifier(etat.bitsGenres[static_cast<std::size_t>(film.genre)]).retirer(film.idDense);
+    modifier(etat.bitsPays[static_cast<std::size_t>(film.pays)]).retirer(film.idDense);
+
+    if (compacterCategories)
+    {
+        if (categorieGenre.nombreRetires * 2 > categorieGenre.films.size())
+        {
+            compacterCategorie(categorieGenre, &EmplacementFilm::positionGenre);
+        }
+        if (categoriePays.nombreRetires * 2 > categoriePays.films.size())
+        {
+            compacterCategorie(categoriePays, &EmplacementFilm::positionPays);
+        }
+    }
 
-	//TODO: Suppression dans filtreGenreFilms_ et filtrePaysFilms_
-	//	initialiser une référence au vecteur du genre/pays du film donné
-	//	effacer l'élement du vecteur à l'aide de sa valeur, et non de son index
-	//		TODO: utiliser erase-remove idiom pour cela
+    if (compacterCategories)
+    {
+        std::vector<const Film*>& filmsParAnnee = modifier(etat.filmsParAnnee);
+        filmsParAnnee.erase(trouverDansIndexAnnees(filmsParAnnee, film));
+    }
 
-		//Pour les Pays
-	std::vector<const Film* >& vecteurPaysFilms = filtrePaysFilms_[filmTrouve.pays]; //initialisation de la référence
-	auto iteratorPays = remove(vecteurPaysFilms.begin(), vecteurPaysFilms.end(), iteratorTrouve->get());
-	vecteurPaysFilms.erase(iteratorPays, vecteurPaysFilms.end());
+    modifier(etat.filmsParIdDense)[film.idDense] = nullptr;
+    modifier(etat.filtreNomFilms[getSeauNom(film.nom)]).erase(film.nom);
+}
 
-		//Pour les Genres
-	std::vector<const Film* >& vecteurGenreFilms = filtreGenreFilms_[filmTrouve.genre]; //initialisation de la référence
-	auto iteratorGenre = remove(vecteurGenreFilms.begin(), vecteurGenreFilms.end(), iteratorTrouve->get());
-	vecteurGenreFilms.erase(iteratorGenre, vecteurGenreFilms.end());
+/// Trouve un film dans l'index par année par une recherche binaire sur l'année et l'identifiant dense.
+/// \param filmsParAnnee    L'index par année.
+/// \param film             Un film présent dans l'index.
+/// \return                 La position du film dans l'index.
+std::vector<const Film*>::iterator GestionnaireFilms::trouverDansIndexAnnees(std::vector<const Film*>& filmsParAnnee,
+                                                                             const Film& film)
+{
+    auto estAvant = [](const Film* film1, const Film* film2) {
+        return film1->annee < film2->annee || (film1->annee == film2->annee && film1->idDense < film2->idDense);
+    };
+    return std::lower_bound(filmsParAnnee.begin(), filmsParAnnee.end(), &film, estAvant);
+}
 
-	//TODO: effacer le film du vecteur de unique_ptr de Films
-	films_.erase(iteratorTrouve);
-	return true;
+/// Enlève les films retirés d'une catégorie en conservant l'ordre des autres et met à jour leur emplacement.
+/// \param categorie    La catégorie à compacter, dont le gestionnaire est le seul propriétaire.
+/// \param position     Le champ de EmplacementFilm qui contient la position des films dans cette catégorie.
+void GestionnaireFilms::compacterCategorie(CategorieFilms& categorie, std::size_t EmplacementFilm::*position)
+{
+    if (categorie.nombreRetires == 0)
+    {
+        return;
+    }
+    categorie.films.erase(std::remove(categorie.films.begin(), categorie.films.end(), nullptr), categorie.films.end());
+    std::vector<EmplacementFilm>& emplacements = modifier(modifierEtat().emplacements);
+    for (std::size_t i = 0; i < categorie.films.size(); i++)
+    {
+        emplacements[categorie.films[i]->idDense].*position = i;
+    }
+    categorie.nombreRetires = 0;
+}
+
+/// Retourne l'état du gestionnaire, pour le lire.
+/// \return             L'état, ou un état vide partagé par tous les gestionnaires vides.
+const GestionnaireFilms::EtatFilms& GestionnaireFilms::getEtat() const
+{
+    static const EtatFilms etatVide;
+    if (etat_ == nullptr)
+    {
+        return etatVide;
+    }
+    return *etat_;
+}
+
+/// Retourne l'état du gestionnaire pour le modifier. Un état partagé avec un instantané est d'abord copié, mais cette
+/// copie ne fait que partager à son tour chacune des parties de l'état: une partie n'est copiée que lorsqu'elle est
+/// modifiée (voir modifier).
+/// \return             L'état, dont le gestionnaire est le seul propriétaire.
+GestionnaireFilms::EtatFilms& GestionnaireFilms::modifierEtat()
+{
+    if (etat_ == nullptr)
+    {
+        etat_ = std::make_shared<EtatFilms>();
+    }
+    return modifier(etat_);
+}
+
+/// Retourne le seau du filtre par nom qui contient un nom.
+/// \param nom          Le nom d'un film.
+/// \return             L'index du seau.
+std::size_t GestionnaireFilms::getSeauNom(std::string_view nom)
+{
+    return std::hash<std::string_view>()(nom) % nombreSeauxNoms;
+}
+
+/// Retourne une vue sur les films d'une catégorie, qui saute les films retirés.
+/// \param categorie    La catégorie.
+/// \return             Une vue sur les films de la catégorie, dans l'ordre d'ajout.
+VueFilms GestionnaireFilms::getVueCategorie(const CategorieFilms& categorie)
+{
+    return VueFilms(categorie.films.data(),
+                    categorie.films.data() + categorie.films.size(),
+                    categorie.films.size() - categorie.nombreRetires);
 }
 
 /// Retourne le nombre de films présentement dans le gestionnaire.
 /// \return             Le nombre de films présentement dans le gestionnaire.
 std::size_t GestionnaireFilms::getNombreFilms() const
 {
-	return films_.size();
+	return getEtat().films->size();
 }
 
 /// Trouve et retourne un film en le cherchant à partir de son nom.
 /// \param nom          Le nom du film à trouver.
 /// \return             Un pointeur vers le film ou nullptr si aucun film avec le nom ne peut être trouvé.
-const Film* GestionnaireFilms::getFilmParNom(const std::string& nom) const
+const Film* GestionnaireFilms::getFilmParNom(std::string_view nom) const
 {
-	auto film = filtreNomFilms_.find(nom);
-	if (film == filtreNomFilms_.end())
+	const SeauNoms& seau = *getEtat().filtreNomFilms[getSeauNom(nom)];
+	auto film = seau.find(nom);
+	if (film == seau.end())
 	{
 		return nullptr;
 	}
 	return film->second;
 }
 
+/// Trouve et retourne un film à partir de son identifiant dense.
+/// \param idDense      L'identifiant dense du film à trouver.
+/// \return             Un pointeur vers le film ou nullptr si aucun film du gestionnaire n'a cet identifiant.
+const Film* GestionnaireFilms::getFilmParIdDense(IdDense idDense) const
+{
+    const std::vector<const Film*>& filmsParIdDense = *getEtat().filmsParIdDense;
+    if (idDense >= filmsParIdDense.size())
+    {
+        return nullptr;
+    }
+    return filmsParIdDense[idDense];
+}
+
+/// Retourne le nombre d'identifiants denses attribués jusqu'à maintenant, qui borne tous les identifiants valides.
+/// \return             Le nombre d'identifiants denses attribués, incluant ceux des films supprimés.
+std::size_t GestionnaireFilms::getNombreIdsDenses() const
+{
+    return getEtat().filmsParIdDense->size();
+}
+
 /// Retourne une copie de la liste des films appartenant à un genre donné.
 /// \param genre        Le genre du film à trouver.
 /// \return             Une copie de la liste des films appartenant à un genre donné.
 std::vector<const Film*> GestionnaireFilms::getFilmsParGenre(Film::Genre genre) const
 {
-	auto it = filtreGenreFilms_.find(genre);
-	if (it == filtreGenreFilms_.end())
-	{
-		return std::vector<const Film*>();
-	}
-	return filtreGenreFilms_.at(genre);
+    VueFilms films = getVueFilmsParGenre(genre);
+    return std::vector<const Film*>(films.begin(), films.end());
 }
 
 /// Retourne une copie de la liste des films appartenant à un pays donné.
@@ -209,24 +741,213 @@ std::vector<const Film*> GestionnaireFilms::getFilmsParGenre(Film::Genre genre)
 /// \return             Une copie de la liste des films appartenant à un pays donné.
 std::vector<const Film*> GestionnaireFilms::getFilmsParPays(Pays pays) const
 {
-	auto it = filtrePaysFilms_.find(pays);
-	if (it != filtrePaysFilms_.end())
-	{
-		return filtrePaysFilms_.at(pays);
-	}
-	return std::vector<const Film*>();
+    VueFilms films = getVueFilmsParPays(pays);
+    return std::vector<const Film*>(films.begin(), films.end());
+}
+
+/// Retourne une vue sur les films d'un genre donné, sans rien copier et avec une seule recherche dans le filtre.
+/// \param genre        Le genre des films.
+/// \return             Une vue sur les films du genre dans l'ordre d'ajout, valide jusqu'à la prochaine modification
+///                     du gestionnaire.
+VueFilms GestionnaireFilms::getVueFilmsParGenre(Film::Genre genre) const
+{
+    const auto& filtreGenreFilms = getEtat().filtreGenreFilms;
+    auto it = filtreGenreFilms.find(genre);
+    if (it == filtreGenreFilms.end())
+    {
+        return VueFilms();
+    }
+    return getVueCategorie(*it->second);
+}
+
+/// Retourne une vue sur les films d'un pays donné, sans rien copier et avec une seule recherche dans le filtre.
+/// \param pays         Le pays des films.
+/// \return             Une vue sur les films du pays dans l'ordre d'ajout, valide jusqu'à la prochaine modification
+///                     du gestionnaire.
+VueFilms GestionnaireFilms::getVueFilmsParPays(Pays pays) const
+{
+    const auto& filtrePaysFilms = getEtat().filtrePaysFilms;
+    auto it = filtrePaysFilms.find(pays);
+    if (it == filtrePaysFilms.end())
+    {
+        return VueFilms();
+    }
+    return getVueCategorie(*it->second);
 }
 
 /// Retourne une liste des films produits entre deux années passées en paramètre.
 /// \param anneeDebut   Année définissant le début de notre intervalle de recherche des films.
 /// \param anneeFin     Année définissant la fin de notre intervalle de recherche des films.
-/// \return             Liste des films produits entre deux années.
-std::vector<const Film*> GestionnaireFilms::getFilmsEntreAnnees(int anneeDebut, int anneeFin)
+/// \return             Liste des films produits entre deux années, triés par année puis dans l'ordre d'ajout.
+std::vector<const Film*> GestionnaireFilms::getFilmsEntreAnnees(int anneeDebut, int anneeFin) const
 {
-	std::vector<const Film*> vecteurRetour;
+    VueFilms films = getVueFilmsEntreAnnees(anneeDebut, anneeFin);
+    return std::vector<const Film*>(films.begin(), films.end());
+}
 
-	//Utiliser foncteur EstDansIntervalleDatesFilm(anneeDebut, anneeFin)
-	copy_if(films_.begin(), films_.end(), RawPointerBackInserter(vecteurRetour), EstDansIntervalleDatesFilm(anneeDebut, anneeFin));
-	return vecteurRetour;
+/// Retourne une vue sur les films produits entre deux années, sans rien copier: les films de l'intervalle sont
+/// contigus dans l'index par année et sont trouvés par deux recherches binaires.
+/// \param anneeDebut   Année définissant le début de l'intervalle (incluse).
+/// \param anneeFin     Année définissant la fin de l'intervalle (incluse).
+/// \return             Une vue triée par année puis dans l'ordre d'ajout, valide jusqu'à la prochaine modification du
+///                     gestionnaire.
+VueFilms GestionnaireFilms::getVueFilmsEntreAnnees(int anneeDebut, int anneeFin) const
+{
+    if (anneeDebut > anneeFin)
+    {
+        return VueFilms();
+    }
+    const std::vector<const Film*>& filmsParAnnee = *getEtat().filmsParAnnee;
+    auto debut = std::lower_bound(filmsParAnnee.begin(), filmsParAnnee.end(), anneeDebut,
+                                  [](const Film* film, int annee) { return film->annee < annee; });
+    auto fin = std::upper_bound(debut, filmsParAnnee.end(), anneeFin,
+                                [](int annee, const Film* film) { return annee < film->annee; });
+    return VueFilms(filmsParAnnee.data() + (debut - filmsParAnnee.begin()),
+                    filmsParAnnee.data() + (fin - filmsParAnnee.begin()));
 }
 
+
+/// Appelle une fonction sur chaque film qui satisfait une requête, sans copier de liste intermédiaire. Seuls les films
+/// de l'index le plus sélectif parmi ceux des critères de la requête (genre, pays, intersection des ensembles de bits
+/// du genre et du pays ou intervalle d'années) sont examinés; les autres critères sont vérifiés sur chacun d'eux.
+/// \param requete      La conjonction de critères.
+/// \param fonction     La fonction appelée sur chaque film trouvé, dans l'ordre de l'index examiné. Elle ne doit pas
+///                     modifier le gestionnaire.
+/// \return             Le nombre de films trouvés, 0 si le genre ou le pays de la requête n'est pas une valeur de
+///                     l'enum.
+std::size_t GestionnaireFilms::rechercherFilms(const RequeteFilms& requete,
+                                               const std::function<void(const Film*)>& fonction) const
+{
+    if ((requete.genre && !estGenreValide(*requete.genre)) || (requete.pays && !estPaysValide(*requete.pays)))
+    {
+        return 0;
+    }
+    const EtatFilms& etat = getEtat();
+    VueFilms candidats(etat.films->data(), etat.films->data() + etat.films->size());
+    auto considererCandidats = [&candidats](VueFilms films) {
+        if (films.size() < candidats.size())
+        {
+            candidats = films;
+        }
+    };
+    if (requete.genre)
+    {
+        considererCandidats(getVueFilmsParGenre(*requete.genre));
+    }
+    if (requete.pays)
+    {
+        considererCandidats(getVueFilmsParPays(*requete.pays));
+    }
+    if (requete.anneeDebut || requete.anneeFin)
+    {
+        considererCandidats(getVueFilmsEntreAnnees(requete.anneeDebut.value_or(INT_MIN),
+                                                   requete.anneeFin.value_or(INT_MAX)));
+    }
+
+    std::size_t nombreTrouves = 0;
+    auto verifierFilm = [&](const Film* film) {
+        if (requete.estSatisfaitePar(*film))
+        {
+            fonction(film);
+            nombreTrouves++;
+        }
+    };
+
+    // Avec un genre et un pays, l'intersection de leurs ensembles de bits peut être plus petite que chaque catégorie
+    if (requete.genre && requete.pays)
+    {
+        EnsembleBits intersection = *etat.bitsGenres[static_cast<std::size_t>(*requete.genre)];
+        intersection &= *etat.bitsPays[static_cast<std::size_t>(*requete.pays)];
+        if (intersection.compter() < candidats.size())
+        {
+            intersection.pourChaque([&](IdDense idDense) { verifierFilm((*etat.filmsParIdDense)[idDense]); });
+            return nombreTrouves;
+        }
+    }
+
+    for (const Film* film : candidats)
+    {
+        verifierFilm(film);
+    }
+    return nombreTrouves;
+}
+
+/// Compte les films qui satisfont une requête.
+/// \param requete      La conjonction de critères.
+/// \return             Le nombre de films trouvés.
+std::size_t GestionnaireFilms::compterFilms(const RequeteFilms& requete) const
+{
+    return rechercherFilms(requete, [](const Film*) {});
+}
+
+/// Retourne une liste des films qui satisfont une requête.
+/// \param requete      La conjonction de critères.
+/// \return             Les films trouvés, dans l'ordre de l'index le plus sélectif de la requête.
+std::vector<const Film*> GestionnaireFilms::getFilms(const RequeteFilms& requete) const
+{
+    std::vector<const Film*> films;
+    rechercherFilms(requete, [&films](const Film* film) { films.push_back(film); });
+    return films;
+}
+
+/// Retourne l'ensemble des identifiants denses des films d'un des genres donnés et d'un des pays donnés. Les unions
+/// et l'intersection se font sur les ensembles de bits, 64 films à la fois.
+/// \param genres       Les genres acceptés, ou une liste vide pour accepter tous les genres. Une valeur hors de
+///                     l'enum n'accepte aucun film.
+/// \param pays         Les pays acceptés, ou une liste vide pour accepter tous les pays.
+/// \return             L'ensemble des identifiants denses des films trouvés.
+EnsembleBits GestionnaireFilms::getEnsembleFilms(const std::vector<Film::Genre>& genres,
+                                                 const std::vector<Pays>& pays) const
+{
+    auto unir = [](const auto& ensembles, const auto& valeurs) {
+        EnsembleBits unionEnsembles;
+        if (valeurs.empty())
+        {
+            for (const std::shared_ptr<EnsembleBits>& ensemble : ensembles)
+            {
+                unionEnsembles |= *ensemble;
+            }
+        }
+        for (auto valeur : valeurs)
+        {
+            // Une valeur hors de l'enum n'a aucun film
+            if (static_cast<std::size_t>(valeur) < ensembles.size())
+            {
+                unionEnsembles |= *ensembles[static_cast<std::size_t>(valeur)];
+            }
+        }
+        return unionEnsembles;
+    };
+
+    EnsembleBits ensembleFilms = unir(getEtat().bitsGenres, genres);
+    if (!pays.empty())
+    {
+        ensembleFilms &= unir(getEtat().bitsPays, pays);
+    }
+    return ensembleFilms;
+}
+
+/// Compte les films d'un des genres donnés et d'un des pays donnés, par popcount sur les ensembles de bits.
+/// \param genres       Les genres acceptés, ou une liste vide pour accepter tous les genres.
+/// \param pays         Les pays acceptés, ou une liste vide pour accepter tous les pays.
+/// \return             Le nombre de films trouvés.
+std::size_t GestionnaireFilms::compterFilmsParGenresEtPays(const std::vector<Film::Genre>& genres,
+                                                           const std::vector<Pays>& pays) const
+{
+    return getEnsembleFilms(genres, pays).compter();
+}
+
+/// Retourne une liste des films d'un des genres donnés et d'un des pays donnés.
+/// \param genres       Les genres acceptés, ou une liste vide pour accepter tous les genres.
+/// \param pays         Les pays acceptés, ou une liste vide pour accepter tous les pays.
+/// \return             Les films trouvés, dans l'ordre de leurs identifiants denses (ordre d'ajout).
+std::vector<const Film*> GestionnaireFilms::getFilmsParGenresEtPays(const std::vector<Film::Genre>& genres,
+                                                                    const std::vector<Pays>& pays) const
+{
+    EnsembleBits ensembleFilms = getEnsembleFilms(genres, pays);
+    std::vector<const Film*> films;
+    films.reserve(ensembleFilms.compter());
+    const std::vector<const Film*>& filmsParIdDense = *getEtat().filmsParIdDense;
+    ensembleFilms.pourChaque([&](IdDense idDense) { films.push_back(filmsParIdDense[idDense]); });
+    return films;
+}
@@ -5,33 +5,73 @@
 /// \last modification 2020-04-17
 
 #include "GestionnaireUtilisateurs.h"
-#include <fstream>
-#include <iomanip>
 #include <iostream>
-#include <sstream>
+#include "FichierMappe.h"
+#include "Instantane.h"
+#include "LecteurChamps.h"
+#include "RedacteurRapport.h"
+
+namespace
+{
+    /// Enregistrement de taille fixe d'un utilisateur dans un instantané.
+    struct EnregistrementUtilisateur
+    {
+        ReferenceChaine id;
+        ReferenceChaine nom;
+        std::int32_t age;
+        std::uint8_t pays;
+        std::uint8_t estSupprime;
+        std::uint16_t reserve;
+    };
+} // namespace
+
+/// Constructeur d'un gestionnaire vide qui interne ses chaînes dans une table partagée, par exemple avec un
+/// gestionnaire de films.
+/// \param poolChaines  La table de chaînes, ou nullptr pour que le gestionnaire crée la sienne.
+GestionnaireUtilisateurs::GestionnaireUtilisateurs(std::shared_ptr<PoolChaines> poolChaines)
+    : poolChaines_(std::move(poolChaines))
+{
+}
+
+/// Constructeur par copie. Les utilisateurs sont ajoutés dans l'ordre de leurs identifiants denses, et leurs chaînes
+/// sont retrouvées dans la table de l'original, qui est partagée plutôt que copiée.
+/// \param other    Le gestionnaire d'utilisateurs à partir duquel copier la classe.
+GestionnaireUtilisateurs::GestionnaireUtilisateurs(const GestionnaireUtilisateurs& other)
+    : poolChaines_(other.poolChaines_)
+{
+    utilisateurs_.reserve(other.utilisateurs_.size());
+    utilisateursParIdDense_.reserve(other.utilisateurs_.size());
+
+    for (const Utilisateur* utilisateur : other.utilisateursParIdDense_)
+    {
+        if (utilisateur != nullptr)
+        {
+            ajouterUtilisateur(*utilisateur);
+        }
+    }
+}
+
+/// Opérateur d'assignation par copie utilisant le copy-and-swap idiom.
+/// \param other    Le gestionnaire d'utilisateurs à partir duquel copier la classe.
+/// \return         Référence à l'objet actuel.
+GestionnaireUtilisateurs& GestionnaireUtilisateurs::operator=(GestionnaireUtilisateurs other)
+{
+    std::swap(poolChaines_, other.poolChaines_);
+    std::swap(poolUtilisateurs_, other.poolUtilisateurs_);
+    std::swap(utilisateurs_, other.utilisateurs_);
+    std::swap(utilisateursParIdDense_, other.utilisateursParIdDense_);
+    return *this;
+}
 
 /// Affiche les informations des utilisateurs gérés par le gestionnaire d'utilisateurs à la sortie du stream donné.
+/// Le texte est formaté par RedacteurRapport dans un tampon plutôt que champ par champ dans le stream.
 /// \param outputStream         Le stream auquel écrire les informations des utilisateurs.
 /// \param gestionnaireFilms    Le gestionnaire d'utilisateurs à afficher au stream.
 /// \return                     Une référence au stream.
 std::ostream& operator<<(std::ostream& outputStream, const GestionnaireUtilisateurs& gestionnaireUtilisateurs)
 {
-    // TODO: Uncomment une fois que la fonction getNombreUtilisateurs est écrite
-    outputStream << "Le gestionnaire d'utilisateurs contient "  << gestionnaireUtilisateurs.getNombreUtilisateurs()
-                 << " utilisateurs:\n";
-
-    // TODO: Réécrire l'implémentation avec des range-based for et structured bindings (voir énoncé du TP)
-
-    /*for (auto it = gestionnaireUtilisateurs.utilisateurs_.cbegin();
-         it != gestionnaireUtilisateurs.utilisateurs_.cend();
-         ++it)
-    {
-        outputStream << '\t' << it->second << '\n';
-    }*/
-	for (const auto& [key, value] : gestionnaireUtilisateurs.utilisateurs_) 
-	{
-		outputStream << '\t' << value << '\n';
-	}
+    RedacteurRapport redacteur(outputStream, RedacteurRapport::Format::Texte);
+    redacteur.ecrireUtilisateurs(gestionnaireUtilisateurs);
     return outputStream;
 }
 
@@ -40,27 +80,32 @@ std::ostream& operator<<(std::ostream& outputStream, const GestionnaireUtilisate
 /// \return             True si tout le chargement s'est effectué avec succès, false sinon.
 bool GestionnaireUtilisateurs::chargerDepuisFichier(const std::string& nomFichier)
 {
-    std::ifstream fichier(nomFichier);
-    if (fichier)
+    FichierMappe fichier(nomFichier);
+    if (fichier.estOuvert())
     {
-        utilisateurs_.clear();
+        vider();
 
         bool succesParsing = true;
 
-        std::string ligne;
-        while (std::getline(fichier, ligne))
+        std::string tamponNom;
+        Utilisateur utilisateur{}; // Caractéristiques de la ligne, dont les chaînes sont internées directement
+        LecteurLignes lecteurLignes(fichier.getContenu());
+        std::string_view ligne;
+        while (lecteurLignes.lireLigne(ligne))
         {
-            std::istringstream stream(ligne);
+            LecteurChamps lecteurChamps(ligne);
 
-            std::string id;
-            std::string nom;
+            std::string_view id;
+            std::string_view nom;
             int age;
             int pays;
 
-            if (stream >> id >> std::quoted(nom) >> age >> pays)
+            if (lecteurChamps.lireMot(id) && lecteurChamps.lireChaine(nom, tamponNom) &&
+                lecteurChamps.lireEntier(age) && lecteurChamps.lireEntier(pays))
             {
-                // TODO: Uncomment une fois que la fonction ajouterUtilisateur est écrite
-                ajouterUtilisateur(Utilisateur{id, nom, age, static_cast<Pays>(pays)});
+                utilisateur.age = age;
+                utilisateur.pays = static_cast<Pays>(pays);
+                ajouterUtilisateur(utilisateur, id, nom);
             }
             else
             {
@@ -76,21 +121,179 @@ bool GestionnaireUtilisateurs::chargerDepuisFichier(const std::string& nomFichie
 }
 
 /// Ajoute un utilisateur au gestionnaire, en l’insérant dans la map avec son ID comme clé et l’utilisateur comme valeur.
+/// La copie conservée est construite dans le pool et reçoit le prochain identifiant dense; son identifiant et son nom
+/// sont internés dans la table de chaînes, et la clé de la map est une vue sur l'identifiant interné.
 /// \param utilisateur  Utilisateur à ajouter.
 /// \return             True si l’utilisateur a été ajouté avec succès, 
 //						False si l’utilisateur n’a pas pu être ajouté puisque son ID était déjà présent dans la map.
 bool GestionnaireUtilisateurs::ajouterUtilisateur(const Utilisateur& utilisateur)
 {
-	return utilisateurs_.emplace(utilisateur.id, utilisateur).second;
+	return ajouterUtilisateur(utilisateur, utilisateur.id, utilisateur.nom);
+}
+
+/// Ajoute un utilisateur dont l'identifiant et le nom sont donnés à part, pour les interner sans passer par une copie
+/// intermédiaire.
+/// \param utilisateur  L'utilisateur à ajouter, dont l'identifiant et le nom sont ignorés.
+/// \param id           L'identifiant de l'utilisateur.
+/// \param nom          Le nom de l'utilisateur.
+/// \return             True si l'utilisateur a été ajouté, false si son identifiant est déjà présent.
+bool GestionnaireUtilisateurs::ajouterUtilisateur(const Utilisateur& utilisateur, std::string_view id,
+                                                  std::string_view nom)
+{
+	if (utilisateurs_.find(id) != utilisateurs_.end())
+	{
+		return false;
+	}
+	PoolChaines& poolChaines = getPoolChaines();
+	Utilisateur* nouvelUtilisateur = poolUtilisateurs_.creer(
+	    Utilisateur{poolChaines.interner(id), poolChaines.interner(nom), utilisateur.age, utilisateur.pays});
+	nouvelUtilisateur->idDense = static_cast<IdDense>(utilisateursParIdDense_.size());
+	utilisateurs_.emplace(nouvelUtilisateur->id, nouvelUtilisateur);
+	utilisateursParIdDense_.push_back(nouvelUtilisateur);
+	return true;
 }
 
 /// Supprime un utilisateur du gestionnaire à partir de son ID.
 /// \param idUtilisateur Identifiant de l'utilisateur à supprimer.
 /// \return             True si l’utilisateur a été trouvé et supprimé avec succès, 
 //						False si l’utilisateur n’a pas pu être supprimé puisque son ID n’était pas déjà présent dans la map.
-bool GestionnaireUtilisateurs::supprimerUtilisateur(const std::string& idUtilisateur)
+bool GestionnaireUtilisateurs::supprimerUtilisateur(std::string_view idUtilisateur)
 {
-	return utilisateurs_.erase(idUtilisateur);
+	auto it = utilisateurs_.find(idUtilisateur);
+	if (it == utilisateurs_.end())
+	{
+		return false;
+	}
+	Utilisateur* utilisateur = it->second;
+	utilisateursParIdDense_[utilisateur->idDense] = nullptr;
+	utilisateurs_.erase(it);
+	poolUtilisateurs_.liberer(utilisateur);
+	return true;
+}
+
+/// Renumérote les utilisateurs restants de 0 à n - 1, dans l'ordre de leurs anciens identifiants denses, pour que les
+/// tableaux indexés par identifiant ne gardent plus de place pour les utilisateurs supprimés. Les utilisateurs ne sont
+/// pas déplacés: les pointeurs obtenus avant la compaction restent valides.
+/// \return             Le nouvel identifiant de chaque ancien identifiant, idDenseInvalide pour un utilisateur
+///                     supprimé.
+std::vector<IdDense> GestionnaireUtilisateurs::compacterIdsDenses()
+{
+    std::vector<IdDense> nouveauxIds(utilisateursParIdDense_.size(), idDenseInvalide);
+    std::vector<const Utilisateur*> utilisateursParIdDense;
+    utilisateursParIdDense.reserve(utilisateurs_.size());
+    for (const Utilisateur* utilisateur : utilisateursParIdDense_)
+    {
+        if (utilisateur != nullptr)
+        {
+            nouveauxIds[utilisateur->idDense] = static_cast<IdDense>(utilisateursParIdDense.size());
+            utilisateursParIdDense.push_back(utilisateur);
+        }
+    }
+    for (auto& [id, utilisateur] : utilisateurs_)
+    {
+        utilisateur->idDense = nouveauxIds[utilisateur->idDense];
+    }
+    utilisateursParIdDense_ = std::move(utilisateursParIdDense);
+    return nouveauxIds;
+}
+
+/// Sauvegarde les utilisateurs dans un instantané binaire, que chargerInstantane recharge sans interpréter de texte.
+/// Chaque identifiant dense, y compris celui d'un utilisateur supprimé, a un enregistrement de taille fixe.
+/// \param nomFichier   Le fichier de l'instantané.
+/// \return             True si l'instantané a été écrit avec succès, false sinon.
+bool GestionnaireUtilisateurs::sauvegarderInstantane(const std::string& nomFichier) const
+{
+    BlocChaines chaines;
+    std::vector<EnregistrementUtilisateur> enregistrements(utilisateursParIdDense_.size());
+    for (std::size_t idDense = 0; idDense < utilisateursParIdDense_.size(); idDense++)
+    {
+        const Utilisateur* utilisateur = utilisateursParIdDense_[idDense];
+        EnregistrementUtilisateur& enregistrement = enregistrements[idDense];
+        if (utilisateur == nullptr)
+        {
+            enregistrement.estSupprime = 1;
+            continue;
+        }
+        enregistrement.id = chaines.ajouter(utilisateur->id);
+        enregistrement.nom = chaines.ajouter(utilisateur->nom);
+        enregistrement.age = utilisateur->age;
+        enregistrement.pays = static_cast<std::uint8_t>(utilisateur->pays);
+    }
+
+    EcrivainInstantane ecrivain(ContenuInstantane::Utilisateurs);
+    ecrivain.ajouterSection(enregistrements);
+    ecrivain.ajouterSection(chaines.getDonnees());
+    if (!chaines.estValide() || !ecrivain.ecrire(nomFichier))
+    {
+        std::cerr << "Erreur GestionnaireUtilisateurs: l'instantané " << nomFichier << " n'a pas pu être écrit\n";
+        return false;
+    }
+    return true;
+}
+
+/// Remplace les utilisateurs du gestionnaire par ceux d'un instantané écrit par sauvegarderInstantane. Les
+/// utilisateurs reçoivent les mêmes identifiants denses qu'au moment de la sauvegarde.
+/// \param nomFichier   Le fichier de l'instantané.
+/// \return             True si l'instantané a été chargé avec succès, false sinon (le gestionnaire est alors vide).
+bool GestionnaireUtilisateurs::chargerInstantane(const std::string& nomFichier)
+{
+    LecteurInstantane lecteur(nomFichier, ContenuInstantane::Utilisateurs);
+    std::vector<EnregistrementUtilisateur> enregistrements;
+    vider();
+    bool succesChargement =
+        lecteur.estValide() && lecteur.getNombreSections() == 2 && lecteur.lireSection(0, enregistrements);
+
+    std::string_view chaines = succesChargement ? lecteur.getSection(1) : std::string_view();
+    utilisateurs_.reserve(enregistrements.size());
+    utilisateursParIdDense_.reserve(enregistrements.size());
+    Utilisateur utilisateurLu{};
+    for (std::size_t i = 0; succesChargement && i < enregistrements.size(); i++)
+    {
+        const EnregistrementUtilisateur& enregistrement = enregistrements[i];
+        if (enregistrement.estSupprime != 0)
+        {
+            utilisateursParIdDense_.push_back(nullptr);
+            continue;
+        }
+        std::string_view id;
+        std::string_view nom;
+        succesChargement = BlocChaines::lireChaine(chaines, enregistrement.id, id) &&
+                           BlocChaines::lireChaine(chaines, enregistrement.nom, nom) &&
+                           enregistrement.pays < nombrePays;
+        if (succesChargement)
+        {
+            utilisateurLu.age = enregistrement.age;
+            utilisateurLu.pays = static_cast<Pays>(enregistrement.pays);
+            succesChargement = ajouterUtilisateur(utilisateurLu, id, nom);
+        }
+    }
+
+    if (!succesChargement)
+    {
+        vider();
+        std::cerr << "Erreur GestionnaireUtilisateurs: l'instantané " << nomFichier << " n'a pas pu être chargé\n";
+    }
+    return succesChargement;
+}
+
+/// Retire tous les utilisateurs du gestionnaire, ainsi que leurs identifiants denses. La table de chaînes garde ses
+/// chaînes.
+void GestionnaireUtilisateurs::vider()
+{
+    utilisateurs_.clear();
+    utilisateursParIdDense_.clear();
+    poolUtilisateurs_.vider();
+}
+
+/// Retourne la table de chaînes du gestionnaire, en la créant si elle n'existe pas encore.
+/// \return             La table de chaînes.
+PoolChaines& GestionnaireUtilisateurs::getPoolChaines()
+{
+    if (poolChaines_ == nullptr)
+    {
+        poolChaines_ = std::make_shared<PoolChaines>();
+    }
+    return *poolChaines_;
 }
 
 /// Retourne le nombre d’utilisateurs présentement dans le gestionnaire.
@@ -103,13 +306,32 @@ std::size_t GestionnaireUtilisateurs::getNombreUtilisateurs() const
 /// Trouve et retourne un utilisateur en le cherchant à partir de son ID.
 /// \param id           L'identifiant de l'utilisateur recherché.
 /// \return             Pointeur vers l'utilisateur dont l'identifiant est donée en paramètre.
-const Utilisateur* GestionnaireUtilisateurs::getUtilisateurParId(const std::string& id) const 
+const Utilisateur* GestionnaireUtilisateurs::getUtilisateurParId(std::string_view id) const
 {
 	auto utilisateur = utilisateurs_.find(id);
 	if (utilisateur == utilisateurs_.end())
 	{
 		return nullptr;
 	}
-	return &(utilisateur->second);
+	return utilisateur->second;
 }
 
+
+/// Trouve et retourne un utilisateur à partir de son identifiant dense.
+/// \param idDense      L'identifiant dense de l'utilisateur recherché.
+/// \return             Pointeur vers l'utilisateur ou nullptr si aucun utilisateur du gestionnaire n'a cet identifiant.
+const Utilisateur* GestionnaireUtilisateurs::getUtilisateurParIdDense(IdDense idDense) const
+{
+    if (idDense >= utilisateursParIdDense_.size())
+    {
+        return nullptr;
+    }
+    return utilisateursParIdDense_[idDense];
+}
+
+/// Retourne le nombre d'identifiants denses attribués jusqu'à maintenant, qui borne tous les identifiants valides.
+/// \return             Le nombre d'identifiants denses attribués, incluant ceux des utilisateurs supprimés.
+std::size_t GestionnaireUtilisateurs::getNombreIdsDenses() const
+{
+    return utilisateursParIdDense_.size();
+}
@@ -0,0 +1,242 @@
+/// Format binaire des instantanés des gestionnaires et de l'analyseur de logs.
+/// \date 2026-10-17
+
+#include "Instantane.h"
+#include <fstream>
+#include <limits>
+
+namespace
+{
+    constexpr char signature[8] = {'T', 'D', '5', 'I', 'N', 'S', 'T', '\0'};
+    constexpr std::uint32_t version = 1;
+    constexpr std::size_t alignement = 8;
+
+    /// En-tête d'un instantané. La somme de contrôle couvre tout ce qui suit l'en-tête.
+    struct EnteteInstantane
+    {
+        char signature[8];
+        std::uint32_t version;
+        std::uint32_t contenu;
+        std::uint32_t nombreSections;
+        std::uint32_t reserve;
+        std::uint64_t taille; // Nombre d'octets après l'en-tête
+        std::uint64_t sommeControle;
+    };
+
+    /// Entrée de la table des sections.
+    struct DescripteurSection
+    {
+        std::uint64_t debut; // Depuis le début du fichier
+        std::uint64_t taille;
+    };
+
+    static_assert(sizeof(EnteteInstantane) % alignement == 0 && sizeof(DescripteurSection) % alignement == 0,
+                  "Les sections doivent rester alignées");
+
+    /// Arrondit une taille au prochain multiple de l'alignement des sections.
+    /// \param taille       La taille.
+    /// \return             La taille arrondie.
+    std::size_t aligner(std::size_t taille)
+    {
+        return (taille + alignement - 1) / alignement * alignement;
+    }
+
+    /// Accumule des octets dans une somme de contrôle FNV-1a calculée 8 octets à la fois. Un dernier mot incomplet est
+    /// complété par des zéros, comme le sont les sections dans le fichier.
+    /// \param somme        La somme de contrôle des octets précédents.
+    /// \param donnees      Les octets à accumuler.
+    /// \param taille       Le nombre d'octets.
+    /// \return             La nouvelle somme de contrôle.
+    std::uint64_t accumulerSommeControle(std::uint64_t somme, const char* donnees, std::size_t taille)
+    {
+        static constexpr std::uint64_t premierFnv = 0x100000001b3ULL;
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= taille; i += sizeof(std::uint64_t))
+        {
+            std::uint64_t mot;
+            std::memcpy(&mot, donnees + i, sizeof(mot));
+            somme = (somme ^ mot) * premierFnv;
+        }
+        if (i < taille)
+        {
+            std::uint64_t mot = 0;
+            std::memcpy(&mot, donnees + i, taille - i);
+            somme = (somme ^ mot) * premierFnv;
+        }
+        return somme;
+    }
+
+    constexpr std::uint64_t sommeControleInitiale = 0xcbf29ce484222325ULL;
+} // namespace
+
+/// Ajoute une chaîne au bloc, à moins qu'elle n'y soit déjà.
+/// \param chaine       La chaîne, qui doit exister jusqu'à la destruction du bloc.
+/// \return             La position de la chaîne dans le bloc.
+ReferenceChaine BlocChaines::ajouter(std::string_view chaine)
+{
+    auto it = references_.find(chaine);
+    if (it != references_.end())
+    {
+        return it->second;
+    }
+    if (donnees_.size() + chaine.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        estValide_ = false;
+        return ReferenceChaine{0, 0};
+    }
+    ReferenceChaine reference{static_cast<std::uint32_t>(donnees_.size()), static_cast<std::uint32_t>(chaine.size())};
+    donnees_.insert(donnees_.end(), chaine.begin(), chaine.end());
+    references_.emplace(chaine, reference);
+    return reference;
+}
+
+/// Indique si toutes les chaînes ajoutées ont pu être placées dans le bloc.
+/// \return             False si le bloc a dépassé 4 Gio, true sinon.
+bool BlocChaines::estValide() const
+{
+    return estValide_;
+}
+
+/// Retourne le contenu du bloc, à écrire comme une section.
+/// \return             Les caractères des chaînes ajoutées, mis bout à bout.
+const std::vector<char>& BlocChaines::getDonnees() const
+{
+    return donnees_;
+}
+
+/// Retrouve une chaîne dans un bloc lu d'un instantané.
+/// \param bloc         La section qui contient le bloc.
+/// \param reference    La position de la chaîne.
+/// \param chaine       La chaîne trouvée, qui pointe dans le bloc.
+/// \return             True si la position est à l'intérieur du bloc, false sinon.
+bool BlocChaines::lireChaine(std::string_view bloc, ReferenceChaine reference, std::string_view& chaine)
+{
+    if (reference.debut > bloc.size() || reference.taille > bloc.size() - reference.debut)
+    {
+        return false;
+    }
+    chaine = bloc.substr(reference.debut, reference.taille);
+    return true;
+}
+
+/// Constructeur.
+/// \param contenu      Le contenu de l'instantané.
+EcrivainInstantane::EcrivainInstantane(ContenuInstantane contenu)
+    : contenu_(contenu)
+{
+}
+
+/// Ajoute une section formée d'octets quelconques. Les octets ne sont pas copiés et doivent exister jusqu'à l'écriture.
+/// \param donnees      Les octets de la section.
+/// \param taille       Le nombre d'octets.
+void EcrivainInstantane::ajouterSection(const void* donnees, std::size_t taille)
+{
+    sections_.push_back(Section{donnees, taille});
+}
+
+/// Écrit l'instantané. La somme de contrôle est calculée sur les sections avant l'écriture, pour écrire le fichier en
+/// un seul passage.
+/// \param nomFichier   Le fichier à créer ou à remplacer.
+/// \return             True si le fichier a été écrit au complet, false sinon.
+bool EcrivainInstantane::ecrire(const std::string& nomFichier) const
+{
+    std::vector<DescripteurSection> descripteurs;
+    descripteurs.reserve(sections_.size());
+    std::uint64_t debut = sizeof(EnteteInstantane) + sections_.size() * sizeof(DescripteurSection);
+    for (const Section& section : sections_)
+    {
+        descripteurs.push_back(DescripteurSection{debut, section.taille});
+        debut += aligner(section.taille);
+    }
+
+    std::uint64_t sommeControle = accumulerSommeControle(sommeControleInitiale,
+                                                         reinterpret_cast<const char*>(descripteurs.data()),
+                                                         descripteurs.size() * sizeof(DescripteurSection));
+    for (const Section& section : sections_)
+    {
+        sommeControle =
+            accumulerSommeControle(sommeControle, static_cast<const char*>(section.donnees), section.taille);
+    }
+
+    EnteteInstantane entete{};
+    std::memcpy(entete.signature, signature, sizeof(signature));
+    entete.version = version;
+    entete.contenu = static_cast<std::uint32_t>(contenu_);
+    entete.nombreSections = static_cast<std::uint32_t>(sections_.size());
+    entete.taille = debut - sizeof(EnteteInstantane);
+    entete.sommeControle = sommeControle;
+
+    std::ofstream fichier(nomFichier, std::ios::binary | std::ios::trunc);
+    fichier.write(reinterpret_cast<const char*>(&entete), sizeof(entete));
+    fichier.write(reinterpret_cast<const char*>(descripteurs.data()),
+                  static_cast<std::streamsize>(descripteurs.size() * sizeof(DescripteurSection)));
+    static constexpr char zeros[alignement] = {};
+    for (const Section& section : sections_)
+    {
+        fichier.write(static_cast<const char*>(section.donnees), static_cast<std::streamsize>(section.taille));
+        fichier.write(zeros, static_cast<std::streamsize>(aligner(section.taille) - section.taille));
+    }
+    fichier.close();
+    return !fichier.fail();
+}
+
+/// Constructeur. Projette le fichier en mémoire et le vérifie au complet; un instantané tronqué, corrompu, d'une autre
+/// version ou d'un autre contenu n'est pas valide.
+/// \param nomFichier   Le fichier de l'instantané.
+/// \param contenu      Le contenu attendu.
+LecteurInstantane::LecteurInstantane(const std::string& nomFichier, ContenuInstantane contenu)
+    : fichier_(nomFichier)
+{
+    std::string_view donnees = fichier_.getContenu();
+    if (!fichier_.estOuvert() || donnees.size() < sizeof(EnteteInstantane))
+    {
+        return;
+    }
+    EnteteInstantane entete;
+    std::memcpy(&entete, donnees.data(), sizeof(entete));
+    std::string_view corps = donnees.substr(sizeof(EnteteInstantane));
+    if (std::memcmp(entete.signature, signature, sizeof(signature)) != 0 || entete.version != version ||
+        entete.contenu != static_cast<std::uint32_t>(contenu) || entete.taille != corps.size() ||
+        corps.size() % alignement != 0 || corps.size() / sizeof(DescripteurSection) < entete.nombreSections ||
+        accumulerSommeControle(sommeControleInitiale, corps.data(), corps.size()) != entete.sommeControle)
+    {
+        return;
+    }
+
+    sections_.reserve(entete.nombreSections);
+    for (std::size_t i = 0; i < entete.nombreSections; i++)
+    {
+        DescripteurSection descripteur;
+        std::memcpy(&descripteur, corps.data() + i * sizeof(DescripteurSection), sizeof(descripteur));
+        if (descripteur.debut > donnees.size() || descripteur.taille > donnees.size() - descripteur.debut)
+        {
+            sections_.clear();
+            return;
+        }
+        sections_.push_back(donnees.substr(static_cast<std::size_t>(descripteur.debut),
+                                           static_cast<std::size_t>(descripteur.taille)));
+    }
+    estValide_ = true;
+}
+
+/// Indique si l'instantané a pu être ouvert et vérifié.
+/// \return             True si l'instantané est valide, false sinon.
+bool LecteurInstantane::estValide() const
+{
+    return estValide_;
+}
+
+/// Retourne le nombre de sections de l'instantané.
+/// \return             Le nombre de sections, 0 si l'instantané n'est pas valide.
+std::size_t LecteurInstantane::getNombreSections() const
+{
+    return sections_.size();
+}
+
+/// Retourne les octets d'une section, dans le fichier projeté en mémoire.
+/// \param index        L'index de la section, inférieur au nombre de sections.
+/// \return             Les octets de la section, valides tant que le lecteur existe.
+std::string_view LecteurInstantane::getSection(std::size_t index) const
+{
+    return sections_[index];
+}
@@ -0,0 +1,160 @@
+/// Stockage en colonnes des lignes du log.
+/// \date 2026-10-17
+
+#include "JournalLogs.h"
+#include <algorithm>
+#include <iterator>
+#include "Foncteurs.h"
+
+/// Réserve la mémoire de chaque colonne pour un nombre de lignes donné.
+/// \param capacite     Le nombre de lignes prévu.
+void JournalLogs::reserver(std::size_t capacite)
+{
+    timestamps_.reserve(capacite);
+    idsUtilisateurs_.reserve(capacite);
+    idsFilms_.reserve(capacite);
+}
+
+/// Ajoute une ligne après toutes les autres, en O(1) amorti. La ligne ne doit pas précéder la dernière ligne du journal.
+/// \param ligneLog     La ligne à ajouter.
+void JournalLogs::ajouterALaFin(const LigneLog& ligneLog)
+{
+    timestamps_.push_back(ligneLog.timestamp);
+    idsUtilisateurs_.push_back(ligneLog.idUtilisateur);
+    idsFilms_.push_back(ligneLog.idFilm);
+}
+
+/// Insère une ligne à sa place en ordre chronologique, après les lignes ayant le même timestamp, comme fusionner.
+/// \param ligneLog     La ligne à insérer.
+void JournalLogs::inserer(const LigneLog& ligneLog)
+{
+    auto position = std::upper_bound(timestamps_.begin(), timestamps_.end(), ligneLog.timestamp) - timestamps_.begin();
+    timestamps_.insert(timestamps_.begin() + position, ligneLog.timestamp);
+    idsUtilisateurs_.insert(idsUtilisateurs_.begin() + position, ligneLog.idUtilisateur);
+    idsFilms_.insert(idsFilms_.begin() + position, ligneLog.idFilm);
+}
+
+/// Ajoute un lot de lignes en ordre chronologique. Le lot est trié une seule fois puis fusionné avec les colonnes
+/// existantes en O(n + m). Les lignes ayant le même timestamp conservent l'ordre du lot et suivent les lignes déjà
+/// présentes.
+/// \param lignesLog    Les lignes à ajouter, dans n'importe quel ordre.
+void JournalLogs::fusionner(std::vector<LigneLog> lignesLog)
+{
+    // Un lot déjà en ordre chronologique n'a pas besoin d'être trié
+    if (!std::is_sorted(lignesLog.begin(), lignesLog.end(), ComparateurLog()))
+    {
+        std::stable_sort(lignesLog.begin(), lignesLog.end(), ComparateurLog());
+    }
+
+    // Cas fréquent: le lot suit toutes les lignes existantes
+    if (lignesLog.empty() || timestamps_.empty() || timestamps_.back() <= lignesLog.front().timestamp)
+    {
+        reserver(getTaille() + lignesLog.size());
+        for (const LigneLog& ligneLog : lignesLog)
+        {
+            ajouterALaFin(ligneLog);
+        }
+        return;
+    }
+
+    JournalLogs resultat;
+    resultat.reserver(getTaille() + lignesLog.size());
+    std::size_t index = 0;
+    for (const LigneLog& ligneLog : lignesLog)
+    {
+        while (index < getTaille() && timestamps_[index] <= ligneLog.timestamp)
+        {
+            resultat.ajouterALaFin(getLigneLog(index++));
+        }
+        resultat.ajouterALaFin(ligneLog);
+    }
+    while (index < getTaille())
+    {
+        resultat.ajouterALaFin(getLigneLog(index++));
+    }
+    *this = std::move(resultat);
+}
+
+/// Retire toutes les lignes du journal.
+void JournalLogs::vider()
+{
+    timestamps_.clear();
+    idsUtilisateurs_.clear();
+    idsFilms_.clear();
+}
+
+/// Remplace toutes les lignes du journal par des colonnes déjà construites, sans les copier.
+/// \param timestamps       La colonne des timestamps, en ordre chronologique.
+/// \param idsUtilisateurs  La colonne des identifiants des utilisateurs.
+/// \param idsFilms         La colonne des identifiants des films.
+/// \return                 True si les colonnes ont la même taille et sont en ordre chronologique, false sinon (le
+///                         journal n'est alors pas modifié).
+bool JournalLogs::assigner(std::vector<Timestamp> timestamps, std::vector<IdDense> idsUtilisateurs,
+                           std::vector<IdDense> idsFilms)
+{
+    if (idsUtilisateurs.size() != timestamps.size() || idsFilms.size() != timestamps.size() ||
+        !std::is_sorted(timestamps.begin(), timestamps.end()))
+    {
+        return false;
+    }
+    timestamps_ = std::move(timestamps);
+    idsUtilisateurs_ = std::move(idsUtilisateurs);
+    idsFilms_ = std::move(idsFilms);
+    return true;
+}
+
+/// Retourne le nombre de lignes du journal.
+/// \return Le nombre de lignes.
+std::size_t JournalLogs::getTaille() const
+{
+    return timestamps_.size();
+}
+
+/// Indique si le journal est vide.
+/// \return True si le journal ne contient aucune ligne, false sinon.
+bool JournalLogs::estVide() const
+{
+    return timestamps_.empty();
+}
+
+/// Reconstitue une ligne du journal à partir de ses colonnes.
+/// \param index        La position de la ligne, en ordre chronologique.
+/// \return             La ligne à cette position.
+LigneLog JournalLogs::getLigneLog(std::size_t index) const
+{
+    return LigneLog{timestamps_[index], idsUtilisateurs_[index], idsFilms_[index]};
+}
+
+/// Trouve par recherche binaire dans la colonne des timestamps les lignes comprises dans un intervalle de temps.
+/// \param debut        Début de l'intervalle, inclus.
+/// \param fin          Fin de l'intervalle, incluse.
+/// \return             Les positions de la première ligne de l'intervalle et de la ligne qui suit la dernière (plage
+///                     vide si fin < debut).
+std::pair<std::size_t, std::size_t> JournalLogs::getPlage(Timestamp debut, Timestamp fin) const
+{
+    auto debutPlage = std::lower_bound(timestamps_.begin(), timestamps_.end(), debut);
+    auto finPlage = fin < debut ? debutPlage : std::upper_bound(debutPlage, timestamps_.end(), fin);
+    return {static_cast<std::size_t>(debutPlage - timestamps_.begin()),
+            static_cast<std::size_t>(finPlage - timestamps_.begin())};
+}
+
+/// Retourne la colonne des timestamps, en ordre croissant.
+/// \return La colonne des timestamps.
+const std::vector<Timestamp>& JournalLogs::getTimestamps() const
+{
+    return timestamps_;
+}
+
+/// Retourne la colonne des identifiants denses des utilisateurs, dans l'ordre des timestamps.
+/// \return La colonne des identifiants des utilisateurs.
+const std::vector<IdDense>& JournalLogs::getIdsUtilisateurs() const
+{
+    return idsUtilisateurs_;
+}
+
+/// Retourne la colonne des identifiants denses des films, dans l'ordre des timestamps.
+/// \return La colonne des identifiants des films.
+const std::vector<IdDense>& JournalLogs::getIdsFilms() const
+{
+    return idsFilms_;
+}
@@ -0,0 +1,153 @@
+/// Fonctions auxiliaires à la struct pour les lignes de log.
+/// \date 2026-10-17
+
+#include "LigneLog.h"
+
+namespace
+{
+    constexpr Timestamp secondesParJour = 24 * 60 * 60;
+
+    /// Convertit une date du calendrier grégorien en nombre de jours depuis 1970-01-01.
+    /// \param annee    L'année.
+    /// \param mois     Le mois, de 1 à 12.
+    /// \param jour     Le jour du mois, à partir de 1.
+    /// \return         Le nombre de jours depuis 1970-01-01 (négatif avant cette date).
+    constexpr Timestamp joursDepuisEpoch(Timestamp annee, Timestamp mois, Timestamp jour)
+    {
+        annee -= mois <= 2 ? 1 : 0;
+        Timestamp ere = (annee >= 0 ? annee : annee - 399) / 400;
+        Timestamp anneeDansEre = annee - ere * 400;
+        Timestamp jourDansAnnee = (153 * (mois > 2 ? mois - 3 : mois + 9) + 2) / 5 + jour - 1;
+        Timestamp jourDansEre = anneeDansEre * 365 + anneeDansEre / 4 - anneeDansEre / 100 + jourDansAnnee;
+        return ere * 146097 + jourDansEre - 719468;
+    }
+
+    /// Retourne le nombre de jours d'un mois.
+    /// \param annee    L'année, pour les années bissextiles.
+    /// \param mois     Le mois, de 1 à 12.
+    /// \return         Le nombre de jours du mois.
+    constexpr int joursDansMois(int annee, int mois)
+    {
+        constexpr int jours[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool estBissextile = (annee % 4 == 0 && annee % 100 != 0) || annee % 400 == 0;
+        return mois == 2 && estBissextile ? 29 : jours[mois - 1];
+    }
+
+    /// Lit un nombre de taille fixe composé uniquement de chiffres.
+    /// \param texte    Le texte contenant les chiffres.
+    /// \param valeur   Reçoit le nombre lu.
+    /// \return         True si tous les caractères sont des chiffres, false sinon.
+    bool lireChiffres(std::string_view texte, int& valeur)
+    {
+        valeur = 0;
+        for (char caractere : texte)
+        {
+            if (caractere < '0' || caractere > '9')
+            {
+                return false;
+            }
+            valeur = valeur * 10 + (caractere - '0');
+        }
+        return true;
+    }
+
+    /// Écrit un nombre sur un nombre fixe de chiffres en le complétant avec des zéros à gauche.
+    /// \param destination  Le tampon dans lequel écrire les chiffres.
+    /// \param valeur       Le nombre positif à écrire.
+    /// \param nombreChiffres Le nombre de chiffres à écrire.
+    void ecrireChiffres(char* destination, Timestamp valeur, int nombreChiffres)
+    {
+        for (int i = nombreChiffres - 1; i >= 0; i--)
+        {
+            destination[i] = static_cast<char>('0' + valeur % 10);
+            valeur /= 10;
+        }
+    }
+
+    /// Affiche un identifiant dense, ou "Inconnu" s'il est invalide.
+    /// \param outputStream Le stream auquel écrire l'identifiant.
+    /// \param idDense      L'identifiant à afficher.
+    void afficherIdDense(std::ostream& outputStream, IdDense idDense)
+    {
+        if (idDense == idDenseInvalide)
+        {
+            outputStream << "Inconnu";
+        }
+        else
+        {
+            outputStream << '#' << idDense;
+        }
+    }
+} // namespace
+
+/// Convertit un timestamp ISO-8601 en UTC de la forme 2016-04-29T17:12:49Z en temps Unix.
+/// \param texte    Le timestamp à convertir.
+/// \return         Le nombre de secondes depuis 1970-01-01T00:00:00Z, ou std::nullopt si le texte n'est pas un
+///                 timestamp valide.
+std::optional<Timestamp> convertirTimestamp(std::string_view texte)
+{
+    static constexpr std::string_view format = "AAAA-MM-JJTHH:MM:SSZ";
+    if (texte.size() != format.size() || texte[4] != '-' || texte[7] != '-' || texte[10] != 'T' ||
+        texte[13] != ':' || texte[16] != ':' || texte[19] != 'Z')
+    {
+        return std::nullopt;
+    }
+
+    int annee, mois, jour, heures, minutes, secondes;
+    if (!lireChiffres(texte.substr(0, 4), annee) || !lireChiffres(texte.substr(5, 2), mois) ||
+        !lireChiffres(texte.substr(8, 2), jour) || !lireChiffres(texte.substr(11, 2), heures) ||
+        !lireChiffres(texte.substr(14, 2), minutes) || !lireChiffres(texte.substr(17, 2), secondes))
+    {
+        return std::nullopt;
+    }
+    if (mois < 1 || mois > 12 || jour < 1 || jour > joursDansMois(annee, mois) || heures > 23 || minutes > 59 ||
+        secondes > 59)
+    {
+        return std::nullopt;
+    }
+
+    return joursDepuisEpoch(annee, mois, jour) * secondesParJour + heures * 3600 + minutes * 60 + secondes;
+}
+
+/// Convertit un temps Unix en timestamp ISO-8601 en UTC de la forme 2016-04-29T17:12:49Z.
+/// \param timestamp    Le nombre de secondes depuis 1970-01-01T00:00:00Z, pour une année entre 0 et 9999.
+/// \return             String représentant le timestamp.
+std::string getTimestampString(Timestamp timestamp)
+{
+    Timestamp jours = (timestamp >= 0 ? timestamp : timestamp - (secondesParJour - 1)) / secondesParJour;
+    Timestamp secondesDansJour = timestamp - jours * secondesParJour;
+
+    // Conversion inverse de joursDepuisEpoch
+    jours += 719468;
+    Timestamp ere = (jours >= 0 ? jours : jours - 146096) / 146097;
+    Timestamp jourDansEre = jours - ere * 146097;
+    Timestamp anneeDansEre = (jourDansEre - jourDansEre / 1460 + jourDansEre / 36524 - jourDansEre / 146096) / 365;
+    Timestamp jourDansAnnee = jourDansEre - (365 * anneeDansEre + anneeDansEre / 4 - anneeDansEre / 100);
+    Timestamp moisDecale = (5 * jourDansAnnee + 2) / 153;
+    Timestamp jour = jourDansAnnee - (153 * moisDecale + 2) / 5 + 1;
+    Timestamp mois = moisDecale < 10 ? moisDecale + 3 : moisDecale - 9;
+    Timestamp annee = anneeDansEre + ere * 400 + (mois <= 2 ? 1 : 0);
+
+    std::string texte = "0000-00-00T00:00:00Z";
+    ecrireChiffres(&texte[0], annee, 4);
+    ecrireChiffres(&texte[5], mois, 2);
+    ecrireChiffres(&texte[8], jour, 2);
+    ecrireChiffres(&texte[11], secondesDansJour / 3600, 2);
+    ecrireChiffres(&texte[14], secondesDansJour / 60 % 60, 2);
+    ecrireChiffres(&texte[17], secondesDansJour % 60, 2);
+    return texte;
+}
+
+/// Affiche les informations d'une ligne de log à la sortie du stream donné. L'utilisateur et le film sont affichés par
+/// leur identifiant dense, puisque la ligne ne connaît pas les gestionnaires.
+/// \param outputStream Le stream auquel écrire les informations de la ligne de log.
+/// \param ligneLog     La ligne de log à afficher au stream.
+/// \return             Une référence au stream.
+std::ostream& operator<<(std::ostream& outputStream, const LigneLog& ligneLog)
+{
+    outputStream << "Date: " << getTimestampString(ligneLog.timestamp) << " | Utilisateur: ";
+    afficherIdDense(outputStream, ligneLog.idUtilisateur);
+    outputStream << " | Film: ";
+    afficherIdDense(outputStream, ligneLog.idFilm);
+    return outputStream;
+}
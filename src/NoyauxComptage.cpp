@@ -0,0 +1,265 @@
+/// Noyaux vectoriels de comptage sur des colonnes d'identifiants denses.
+/// \date 2026-10-17
+
+#include "NoyauxComptage.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define NOYAUX_COMPTAGE_X86_64 true
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define NOYAUX_COMPTAGE_X86_64 false
+#endif
+
+// GCC et Clang n'acceptent les instructions AVX2 que dans les fonctions compilées pour cette cible, ce qui permet de
+// garder le reste du programme compatible avec les processeurs qui ne les supportent pas
+#if NOYAUX_COMPTAGE_X86_64 && (defined(__GNUC__) || defined(__clang__))
+#define CIBLE_AVX2 __attribute__((target("avx2")))
+#else
+#define CIBLE_AVX2
+#endif
+
+namespace
+{
+    /// Nombre de clés comptées par un accumulateur vectoriel avant d'être additionné au total, pour qu'aucune de ses
+    /// voies de 32 bits ne puisse déborder.
+    constexpr std::size_t tailleBlocAccumulation = std::size_t{1} << 30;
+
+    /// Nombre maximal de compteurs pour lequel l'histogramme utilise des sous-histogrammes entrelacés.
+    constexpr std::size_t nombreMaximalCompteursEntrelaces = std::size_t{1} << 16;
+
+    /// Compte les clés égales à une clé donnée, une à la fois.
+    /// \param cles         Les clés à parcourir.
+    /// \param nombreCles   Le nombre de clés.
+    /// \param cle          La clé recherchée.
+    /// \return             Le nombre de clés égales à la clé recherchée.
+    std::size_t compterEgauxScalaire(const IdDense* cles, std::size_t nombreCles, IdDense cle)
+    {
+        std::size_t nombre = 0;
+        for (std::size_t i = 0; i < nombreCles; i++)
+        {
+            nombre += cles[i] == cle ? 1 : 0;
+        }
+        return nombre;
+    }
+
+#if NOYAUX_COMPTAGE_X86_64
+    /// Compte les clés égales à une clé donnée, 4 à la fois avec SSE2. Chaque comparaison donne -1 dans les voies
+    /// égales, qui sont soustraites de l'accumulateur.
+    /// \param cles         Les clés à parcourir.
+    /// \param nombreCles   Le nombre de clés.
+    /// \param cle          La clé recherchée.
+    /// \return             Le nombre de clés égales à la clé recherchée.
+    std::size_t compterEgauxSse2(const IdDense* cles, std::size_t nombreCles, IdDense cle)
+    {
+        static constexpr std::size_t nombreVoies = 4;
+        const __m128i cleRecherchee = _mm_set1_epi32(static_cast<int>(cle));
+
+        std::size_t nombre = 0;
+        std::size_t i = 0;
+        while (nombreCles - i >= nombreVoies)
+        {
+            std::size_t finBloc = i + std::min((nombreCles - i) / nombreVoies * nombreVoies, tailleBlocAccumulation);
+            __m128i accumulateur = _mm_setzero_si128();
+            for (; i < finBloc; i += nombreVoies)
+            {
+                __m128i bloc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cles + i));
+                accumulateur = _mm_sub_epi32(accumulateur, _mm_cmpeq_epi32(bloc, cleRecherchee));
+            }
+
+            alignas(16) std::array<std::uint32_t, nombreVoies> voies;
+            _mm_store_si128(reinterpret_cast<__m128i*>(voies.data()), accumulateur);
+            for (std::uint32_t voie : voies)
+            {
+                nombre += voie;
+            }
+        }
+        return nombre + compterEgauxScalaire(cles + i, nombreCles - i, cle);
+    }
+
+    /// Compte les clés égales à une clé donnée, 8 à la fois avec AVX2. Ne doit être appelée que si le processeur
+    /// supporte AVX2.
+    /// \param cles         Les clés à parcourir.
+    /// \param nombreCles   Le nombre de clés.
+    /// \param cle          La clé recherchée.
+    /// \return             Le nombre de clés égales à la clé recherchée.
+    CIBLE_AVX2 std::size_t compterEgauxAvx2(const IdDense* cles, std::size_t nombreCles, IdDense cle)
+    {
+        static constexpr std::size_t nombreVoies = 8;
+        const __m256i cleRecherchee = _mm256_set1_epi32(static_cast<int>(cle));
+
+        std::size_t nombre = 0;
+        std::size_t i = 0;
+        while (nombreCles - i >= nombreVoies)
+        {
+            std::size_t finBloc = i + std::min((nombreCles - i) / nombreVoies * nombreVoies, tailleBlocAccumulation);
+            __m256i accumulateur = _mm256_setzero_si256();
+            for (; i < finBloc; i += nombreVoies)
+            {
+                __m256i bloc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cles + i));
+                accumulateur = _mm256_sub_epi32(accumulateur, _mm256_cmpeq_epi32(bloc, cleRecherchee));
+            }
+
+            alignas(32) std::array<std::uint32_t, nombreVoies> voies;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(voies.data()), accumulateur);
+            for (std::uint32_t voie : voies)
+            {
+                nombre += voie;
+            }
+        }
+        return nombre + compterEgauxScalaire(cles + i, nombreCles - i, cle);
+    }
+#endif
+
+    /// Vérifie si le processeur et le système d'exploitation supportent les instructions AVX2.
+    /// \return True si AVX2 peut être utilisé, false sinon.
+    bool processeurSupporteAvx2()
+    {
+#if NOYAUX_COMPTAGE_X86_64 && defined(_MSC_VER)
+        std::array<int, 4> registres;
+        __cpuid(registres.data(), 0);
+        if (registres[0] < 7)
+        {
+            return false;
+        }
+        __cpuid(registres.data(), 1);
+        bool supporteOsxsave = (registres[2] & (1 << 27)) != 0;
+        bool supporteAvx = (registres[2] & (1 << 28)) != 0;
+        if (!supporteOsxsave || !supporteAvx || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+        __cpuidex(registres.data(), 7, 0);
+        return (registres[1] & (1 << 5)) != 0;
+#elif NOYAUX_COMPTAGE_X86_64
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+} // namespace
+
+namespace NoyauxComptage
+{
+    /// Retourne l'implémentation la plus rapide supportée par le processeur. La détection n'est faite qu'une fois.
+    /// \return La meilleure implémentation supportée.
+    Implementation getMeilleureImplementation()
+    {
+        static const Implementation meilleureImplementation = []() {
+            if (processeurSupporteAvx2())
+            {
+                return Implementation::Avx2;
+            }
+            return NOYAUX_COMPTAGE_X86_64 ? Implementation::Sse2 : Implementation::Scalaire;
+        }();
+        return meilleureImplementation;
+    }
+
+    /// Indique si une implémentation peut être utilisée sur ce processeur.
+    /// \param implementation   L'implémentation à vérifier.
+    /// \return                 True si l'implémentation est supportée, false sinon.
+    bool estSupportee(Implementation implementation)
+    {
+        return static_cast<int>(implementation) <= static_cast<int>(getMeilleureImplementation());
+    }
+
+    /// Retourne le nom d'une implémentation, pour l'affichage.
+    /// \param implementation   L'implémentation.
+    /// \return                 Le nom de l'implémentation.
+    const char* getNomImplementation(Implementation implementation)
+    {
+        switch (implementation)
+        {
+            case Implementation::Scalaire:
+                return "scalaire";
+            case Implementation::Sse2:
+                return "SSE2";
+            case Implementation::Avx2:
+                return "AVX2";
+        }
+        return "inconnue";
+    }
+
+    /// Compte les clés égales à une clé donnée avec la meilleure implémentation supportée.
+    /// \param cles         Les clés à parcourir, par exemple une colonne de JournalLogs.
+    /// \param nombreCles   Le nombre de clés.
+    /// \param cle          La clé recherchée.
+    /// \return             Le nombre de clés égales à la clé recherchée.
+    std::size_t compterEgaux(const IdDense* cles, std::size_t nombreCles, IdDense cle)
+    {
+        return compterEgaux(cles, nombreCles, cle, getMeilleureImplementation());
+    }
+
+    /// Compte les clés égales à une clé donnée avec une implémentation choisie. Une implémentation non supportée par
+    /// le processeur est remplacée par l'implémentation scalaire.
+    /// \param cles             Les clés à parcourir.
+    /// \param nombreCles       Le nombre de clés.
+    /// \param cle              La clé recherchée.
+    /// \param implementation   L'implémentation à utiliser.
+    /// \return                 Le nombre de clés égales à la clé recherchée.
+    std::size_t compterEgaux(const IdDense* cles, std::size_t nombreCles, IdDense cle, Implementation implementation)
+    {
+        if (!estSupportee(implementation))
+        {
+            implementation = Implementation::Scalaire;
+        }
+        switch (implementation)
+        {
+#if NOYAUX_COMPTAGE_X86_64
+            case Implementation::Avx2:
+                return compterEgauxAvx2(cles, nombreCles, cle);
+            case Implementation::Sse2:
+                return compterEgauxSse2(cles, nombreCles, cle);
+#endif
+            default:
+                return compterEgauxScalaire(cles, nombreCles, cle);
+        }
+    }
+
+    /// Ajoute aux compteurs le nombre d'occurrences de chaque clé. AVX2 n'a pas d'instruction pour détecter les clés
+    /// répétées dans un même vecteur; l'histogramme utilise plutôt quatre sous-histogrammes entrelacés, pour que deux
+    /// clés consécutives identiques n'attendent pas l'une après l'autre l'écriture du même compteur.
+    /// \param cles         Les clés à compter.
+    /// \param nombreCles   Le nombre de clés.
+    /// \param compteurs    Les compteurs, indexés par clé. Toutes les clés doivent être plus petites que leur nombre.
+    void accumulerHistogramme(const IdDense* cles, std::size_t nombreCles, std::vector<int>& compteurs)
+    {
+        static constexpr std::size_t nombreSousHistogrammes = 4;
+        if (compteurs.size() > nombreMaximalCompteursEntrelaces || nombreCles < compteurs.size())
+        {
+            for (std::size_t i = 0; i < nombreCles; i++)
+            {
+                compteurs[cles[i]]++;
+            }
+            return;
+        }
+
+        // Les sous-compteurs d'une même clé sont voisins et partagent donc la même ligne de cache
+        std::vector<int> sousHistogrammes(compteurs.size() * nombreSousHistogrammes, 0);
+        std::size_t i = 0;
+        for (; i + nombreSousHistogrammes <= nombreCles; i += nombreSousHistogrammes)
+        {
+            for (std::size_t j = 0; j < nombreSousHistogrammes; j++)
+            {
+                sousHistogrammes[cles[i + j] * nombreSousHistogrammes + j]++;
+            }
+        }
+        for (; i < nombreCles; i++)
+        {
+            sousHistogrammes[cles[i] * nombreSousHistogrammes]++;
+        }
+
+        for (std::size_t cle = 0; cle < compteurs.size(); cle++)
+        {
+            for (std::size_t j = 0; j < nombreSousHistogrammes; j++)
+            {
+                compteurs[cle] += sousHistogrammes[cle * nombreSousHistogrammes + j];
+            }
+        }
+    }
+} // namespace NoyauxComptage
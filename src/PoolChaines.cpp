@@ -0,0 +1,27 @@
+/// Table de chaînes de caractères internées.
+/// \date 2026-10-17
+
+#include "PoolChaines.h"
+
+/// Retourne la copie d'une chaîne dans la table, en la copiant dans l'arène si la table ne l'a pas encore.
+/// \param chaine   La chaîne à interner.
+/// \return         La copie, qui partage ses caractères avec toutes les chaînes égales internées dans la table.
+ChaineArena PoolChaines::interner(std::string_view chaine)
+{
+    std::lock_guard<std::mutex> verrou(mutex_);
+    auto copie = chaines_.find(chaine);
+    if (copie == chaines_.end())
+    {
+        ChaineArena nouvelleCopie = arene_.ajouter(chaine);
+        copie = chaines_.emplace(nouvelleCopie, nouvelleCopie).first;
+    }
+    return copie->second;
+}
+
+/// Retourne le nombre de chaînes distinctes dans la table.
+/// \return Le nombre de chaînes.
+std::size_t PoolChaines::getNombreChaines() const
+{
+    std::lock_guard<std::mutex> verrou(mutex_);
+    return chaines_.size();
+}
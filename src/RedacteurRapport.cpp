@@ -0,0 +1,289 @@
+/// Rédacteur de rapports sur les films et les utilisateurs.
+/// \date 2026-10-17
+
+#include "RedacteurRapport.h"
+#include <charconv>
+#include "GestionnaireFilms.h"
+#include "GestionnaireUtilisateurs.h"
+
+/// Constructeur.
+/// \param sortie       Le stream qui reçoit le rapport.
+/// \param format       Le format du rapport.
+/// \param tailleTampon La taille du tampon, en octets, à partir de laquelle il est remis au stream.
+RedacteurRapport::RedacteurRapport(std::ostream& sortie, Format format, std::size_t tailleTampon)
+    : sortie_(sortie)
+    , format_(format)
+    , tailleTampon_(tailleTampon)
+{
+    // Un enregistrement peut dépasser la taille du tampon avant qu'il ne soit vidé
+    tampon_.reserve(tailleTampon_ + 1024);
+}
+
+/// Destructeur, qui remet au stream ce qui reste dans le tampon.
+RedacteurRapport::~RedacteurRapport()
+{
+    vider();
+}
+
+/// Écrit tous les films d'un gestionnaire. En texte, les films sont regroupés par genre comme dans l'opérateur <<;
+/// en CSV et en JSON, ils sont écrits un par ligne dans l'ordre d'ajout.
+/// \param gestionnaireFilms    Le gestionnaire de films.
+void RedacteurRapport::ecrireFilms(const GestionnaireFilms& gestionnaireFilms)
+{
+    switch (format_)
+    {
+        case Format::Texte:
+            ajouter("Le gestionnaire de films contient ");
+            ajouterEntier(static_cast<long long>(gestionnaireFilms.getNombreFilms()));
+            ajouter(" films.\nAffichage par catégories:\n");
+            for (const auto& [genre, categorie] : gestionnaireFilms.getEtat().filtreGenreFilms)
+            {
+                VueFilms films = GestionnaireFilms::getVueCategorie(*categorie);
+                ajouter("Genre: ");
+                ajouter(getGenreString(genre));
+                ajouter(" (");
+                ajouterEntier(static_cast<long long>(films.size()));
+                ajouter(" films):\n");
+                for (const Film* film : films)
+                {
+                    ecrireFilm(*film, false);
+                }
+            }
+            break;
+        case Format::Csv:
+            ajouter("nom,genre,pays,realisateur,annee\n");
+            break;
+        case Format::Json:
+            ajouter("[");
+            break;
+    }
+
+    if (format_ != Format::Texte)
+    {
+        bool estPremier = true;
+        for (const Film* film : *gestionnaireFilms.getEtat().filmsParIdDense)
+        {
+            if (film != nullptr)
+            {
+                ecrireFilm(*film, estPremier);
+                estPremier = false;
+            }
+        }
+        if (format_ == Format::Json)
+        {
+            ajouter("\n]\n");
+        }
+    }
+}
+
+/// Écrit tous les utilisateurs d'un gestionnaire, dans le même ordre que l'opérateur <<.
+/// \param gestionnaireUtilisateurs Le gestionnaire d'utilisateurs.
+void RedacteurRapport::ecrireUtilisateurs(const GestionnaireUtilisateurs& gestionnaireUtilisateurs)
+{
+    switch (format_)
+    {
+        case Format::Texte:
+            ajouter("Le gestionnaire d'utilisateurs contient ");
+            ajouterEntier(static_cast<long long>(gestionnaireUtilisateurs.getNombreUtilisateurs()));
+            ajouter(" utilisateurs:\n");
+            break;
+        case Format::Csv:
+            ajouter("id,nom,age,pays\n");
+            break;
+        case Format::Json:
+            ajouter("[");
+            break;
+    }
+
+    bool estPremier = true;
+    for (const auto& [id, utilisateur] : gestionnaireUtilisateurs.utilisateurs_)
+    {
+        ecrireUtilisateur(*utilisateur, estPremier);
+        estPremier = false;
+    }
+    if (format_ == Format::Json)
+    {
+        ajouter("\n]\n");
+    }
+}
+
+/// Remet le contenu du tampon au stream de sortie en un seul appel, puis vide le tampon sans libérer sa mémoire.
+void RedacteurRapport::vider()
+{
+    if (!tampon_.empty())
+    {
+        sortie_.write(tampon_.data(), static_cast<std::streamsize>(tampon_.size()));
+        tampon_.clear();
+    }
+}
+
+/// Écrit un film dans le format du rapport.
+/// \param film         Le film.
+/// \param estPremier   True si c'est le premier élément de la liste, pour les séparateurs JSON.
+void RedacteurRapport::ecrireFilm(const Film& film, bool estPremier)
+{
+    switch (format_)
+    {
+        case Format::Texte:
+            ajouter("\tNom: ");
+            ajouter(film.nom);
+            ajouter(" | Genre: ");
+            ajouter(getGenreString(film.genre));
+            ajouter(" | Pays: ");
+            ajouter(getPaysString(film.pays));
+            ajouter(" | Réalisateur: ");
+            ajouter(film.realisateur);
+            ajouter(" | Année: ");
+            ajouterEntier(film.annee);
+            ajouter("\n");
+            break;
+        case Format::Csv:
+            ajouterChaineCsv(film.nom);
+            ajouter(",");
+            ajouterChaineCsv(getGenreString(film.genre));
+            ajouter(",");
+            ajouterChaineCsv(getPaysString(film.pays));
+            ajouter(",");
+            ajouterChaineCsv(film.realisateur);
+            ajouter(",");
+            ajouterEntier(film.annee);
+            ajouter("\n");
+            break;
+        case Format::Json:
+            ajouter(estPremier ? "\n" : ",\n");
+            ajouter("{\"nom\":");
+            ajouterChaineJson(film.nom);
+            ajouter(",\"genre\":");
+            ajouterChaineJson(getGenreString(film.genre));
+            ajouter(",\"pays\":");
+            ajouterChaineJson(getPaysString(film.pays));
+            ajouter(",\"realisateur\":");
+            ajouterChaineJson(film.realisateur);
+            ajouter(",\"annee\":");
+            ajouterEntier(film.annee);
+            ajouter("}");
+            break;
+    }
+    viderSiPlein();
+}
+
+/// Écrit un utilisateur dans le format du rapport.
+/// \param utilisateur  L'utilisateur.
+/// \param estPremier   True si c'est le premier élément de la liste, pour les séparateurs JSON.
+void RedacteurRapport::ecrireUtilisateur(const Utilisateur& utilisateur, bool estPremier)
+{
+    switch (format_)
+    {
+        case Format::Texte:
+            ajouter("\tIdentifiant: ");
+            ajouter(utilisateur.id);
+            ajouter(" | Nom: ");
+            ajouter(utilisateur.nom);
+            ajouter(" | Âge: ");
+            ajouterEntier(utilisateur.age);
+            ajouter(" | Pays: ");
+            ajouter(getPaysString(utilisateur.pays));
+            ajouter("\n");
+            break;
+        case Format::Csv:
+            ajouterChaineCsv(utilisateur.id);
+            ajouter(",");
+            ajouterChaineCsv(utilisateur.nom);
+            ajouter(",");
+            ajouterEntier(utilisateur.age);
+            ajouter(",");
+            ajouterChaineCsv(getPaysString(utilisateur.pays));
+            ajouter("\n");
+            break;
+        case Format::Json:
+            ajouter(estPremier ? "\n" : ",\n");
+            ajouter("{\"id\":");
+            ajouterChaineJson(utilisateur.id);
+            ajouter(",\"nom\":");
+            ajouterChaineJson(utilisateur.nom);
+            ajouter(",\"age\":");
+            ajouterEntier(utilisateur.age);
+            ajouter(",\"pays\":");
+            ajouterChaineJson(getPaysString(utilisateur.pays));
+            ajouter("}");
+            break;
+    }
+    viderSiPlein();
+}
+
+/// Ajoute du texte au tampon.
+/// \param texte    Le texte.
+void RedacteurRapport::ajouter(std::string_view texte)
+{
+    tampon_.append(texte);
+}
+
+/// Ajoute un entier en base 10 au tampon, sans passer par un stream.
+/// \param valeur   L'entier.
+void RedacteurRapport::ajouterEntier(long long valeur)
+{
+    char chiffres[24];
+    auto [fin, erreur] = std::to_chars(chiffres, chiffres + sizeof(chiffres), valeur);
+    tampon_.append(chiffres, fin);
+}
+
+/// Ajoute un champ CSV au tampon, entre guillemets seulement s'il contient une virgule, un guillemet ou une fin de
+/// ligne (RFC 4180).
+/// \param texte    Le contenu du champ.
+void RedacteurRapport::ajouterChaineCsv(std::string_view texte)
+{
+    if (texte.find_first_of(",\"\r\n") == std::string_view::npos)
+    {
+        tampon_.append(texte);
+        return;
+    }
+    tampon_.push_back('"');
+    for (char caractere : texte)
+    {
+        if (caractere == '"')
+        {
+            tampon_.push_back('"');
+        }
+        tampon_.push_back(caractere);
+    }
+    tampon_.push_back('"');
+}
+
+/// Ajoute une chaîne JSON au tampon, avec ses guillemets et ses échappements. Les caractères UTF-8 sont copiés tels
+/// quels.
+/// \param texte    Le contenu de la chaîne.
+void RedacteurRapport::ajouterChaineJson(std::string_view texte)
+{
+    static constexpr char chiffresHexadecimaux[] = "0123456789abcdef";
+
+    tampon_.push_back('"');
+    for (char caractere : texte)
+    {
+        auto octet = static_cast<unsigned char>(caractere);
+        if (caractere == '"' || caractere == '\\')
+        {
+            tampon_.push_back('\\');
+            tampon_.push_back(caractere);
+        }
+        else if (octet < 0x20)
+        {
+            tampon_.append("\\u00");
+            tampon_.push_back(chiffresHexadecimaux[octet >> 4]);
+            tampon_.push_back(chiffresHexadecimaux[octet & 0xF]);
+        }
+        else
+        {
+            tampon_.push_back(caractere);
+        }
+    }
+    tampon_.push_back('"');
+}
+
+/// Remet le tampon au stream s'il a atteint sa taille.
+void RedacteurRapport::viderSiPlein()
+{
+    if (tampon_.size() >= tailleTampon_)
+    {
+        vider();
+    }
+}
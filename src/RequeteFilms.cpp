@@ -0,0 +1,14 @@
+/// Requête composée sur les films.
+/// \date 2026-10-17
+
+#include "RequeteFilms.h"
+
+/// Vérifie si un film satisfait tous les critères de la requête.
+/// \param film     Le film à vérifier.
+/// \return         True si le film satisfait tous les critères non vides, false sinon.
+bool RequeteFilms::estSatisfaitePar(const Film& film) const
+{
+    return (!genre || film.genre == *genre) && (!pays || film.pays == *pays) &&
+           (!anneeDebut || film.annee >= *anneeDebut) && (!anneeFin || film.annee <= *anneeFin) &&
+           (!realisateur || film.realisateur == *realisateur);
+}
@@ -0,0 +1,103 @@
+/// Statistiques des logs publiées aux threads lecteurs.
+/// \date 2026-10-17
+
+#include "StatistiquesLogs.h"
+#include <algorithm>
+#include "NoyauxComptage.h"
+
+/// Retourne le nombre de lignes de log de cette version.
+/// \return                         Le nombre de lignes de tous les segments.
+std::size_t StatistiquesLogs::getNombreLignes() const
+{
+    std::size_t nombreLignes = 0;
+    for (const std::shared_ptr<const JournalLogs>& segment : segments_)
+    {
+        nombreLignes += segment->getTaille();
+    }
+    return nombreLignes;
+}
+
+/// Retourne le nombre de vues d'un film.
+/// \param film                     Le film.
+/// \return                         Le nombre de vues du film, 0 s'il est inconnu.
+int StatistiquesLogs::getNombreVuesFilm(const Film* film) const
+{
+    IdDense idFilm = getIdFilm(film);
+    if (idFilm == idDenseInvalide)
+    {
+        return 0;
+    }
+    return vuesFilms_[idFilm];
+}
+
+/// Retourne le film le plus populaire.
+/// \return                         Le film le plus vu, nullptr si aucune ligne n'a été publiée.
+const Film* StatistiquesLogs::getFilmPlusPopulaire() const
+{
+    if (classement_.empty())
+    {
+        return nullptr;
+    }
+    return films_[classement_.front().first];
+}
+
+/// Retourne les films les plus vus et leur nombre de vues.
+/// \param nombre                   Le nombre de films à retourner.
+/// \return                         Les films les plus vus, en ordre décroissant de vues.
+std::vector<std::pair<const Film*, int>> StatistiquesLogs::getNFilmsPlusPopulaires(std::size_t nombre) const
+{
+    std::vector<std::pair<const Film*, int>> filmsPopulaires;
+    filmsPopulaires.reserve(std::min(nombre, classement_.size()));
+    for (std::size_t i = 0; i < classement_.size() && i < nombre; i++)
+    {
+        filmsPopulaires.emplace_back(films_[classement_[i].first], classement_[i].second);
+    }
+    return filmsPopulaires;
+}
+
+/// Retourne le nombre de films vus par un utilisateur.
+/// \param utilisateur              L'utilisateur.
+/// \return                         Le nombre de vues de l'utilisateur, 0 s'il est inconnu.
+int StatistiquesLogs::getNombreVuesPourUtilisateur(const Utilisateur* utilisateur) const
+{
+    if (utilisateur == nullptr || utilisateur->idDense >= utilisateurs_.size() ||
+        utilisateurs_[utilisateur->idDense] != utilisateur)
+    {
+        return 0;
+    }
+    return vuesUtilisateurs_[utilisateur->idDense];
+}
+
+/// Retourne le nombre de vues d'un film entre deux moments, en additionnant le compte de chaque segment.
+/// \param film                     Le film.
+/// \param debut                    Début de l'intervalle, inclus.
+/// \param fin                      Fin de l'intervalle, incluse.
+/// \return                         Le nombre de vues du film dans l'intervalle.
+int StatistiquesLogs::getNombreVuesFilmEntre(const Film* film, Timestamp debut, Timestamp fin) const
+{
+    IdDense idFilm = getIdFilm(film);
+    if (idFilm == idDenseInvalide)
+    {
+        return 0;
+    }
+    std::size_t nombreVues = 0;
+    for (const std::shared_ptr<const JournalLogs>& segment : segments_)
+    {
+        auto [debutPlage, finPlage] = segment->getPlage(debut, fin);
+        nombreVues +=
+            NoyauxComptage::compterEgaux(segment->getIdsFilms().data() + debutPlage, finPlage - debutPlage, idFilm);
+    }
+    return static_cast<int>(nombreVues);
+}
+
+/// Retourne l'identifiant dense d'un film connu de cette version.
+/// \param film                     Le film.
+/// \return                         L'identifiant dense, ou idDenseInvalide si le film est inconnu.
+IdDense StatistiquesLogs::getIdFilm(const Film* film) const
+{
+    if (film == nullptr || film->idDense >= films_.size() || films_[film->idDense] != film)
+    {
+        return idDenseInvalide;
+    }
+    return film->idDense;
+}
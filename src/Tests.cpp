@@ -5,14 +5,27 @@
 #include "Tests.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <sstream>
+#include <thread>
 #include <vector>
 #include "AnalyseurLogs.h"
 #include "Foncteurs.h"
 #include "GestionnaireFilms.h"
 #include "GestionnaireUtilisateurs.h"
+#include "NoyauxComptage.h"
+#include "PoolChaines.h"
+#include "RedacteurRapport.h"
 
 namespace
 {
@@ -236,6 +249,44 @@ namespace Tests
         tests.push_back(sortieRecue == sortieAttendue);
         afficherResultatTest(5, "GestionnaireUtilisateurs::operator<<", tests.back());
 
+        // Test 6
+        std::string ligneLue = "karasik@msn.com 42";
+        std::string_view idLu = std::string_view(ligneLue).substr(0, ligneLue.find(' '));
+        gestionnaireUtilisateurs.ajouterUtilisateur(utilisateur1);
+        Utilisateur utilisateurTemporaire{"temporaire." + std::to_string(1) + "@email.com",
+                                          std::string(40, 'n'), 30, Pays::Japon};
+        gestionnaireUtilisateurs.ajouterUtilisateur(utilisateurTemporaire);
+        const Utilisateur* utilisateurGere = gestionnaireUtilisateurs.getUtilisateurParId(utilisateurTemporaire.id);
+        utilisateurTemporaire.id = "autre@email.com";
+        utilisateurTemporaire.nom = ChaineArena();
+        GestionnaireUtilisateurs gestionnaireUtilisateurs2(gestionnaireUtilisateurs);
+        const Utilisateur* utilisateurCopie = gestionnaireUtilisateurs2.getUtilisateurParId(idLu);
+        tests.push_back(gestionnaireUtilisateurs.getUtilisateurParId(idLu) != nullptr && utilisateurGere != nullptr &&
+                        gestionnaireUtilisateurs.getUtilisateurParId("temporaire.1@email.com") == utilisateurGere &&
+                        utilisateurGere->nom == std::string(40, 'n') &&
+                        gestionnaireUtilisateurs.getUtilisateurParId("autre@email.com") == nullptr &&
+                        utilisateurCopie != nullptr && utilisateurCopie->id.data() != idLu.data() &&
+                        gestionnaireUtilisateurs2.getNombreUtilisateurs() == 102);
+        afficherResultatTest(6, "Recherche par string_view", tests.back());
+
+        // Test 7
+        auto poolChaines = std::make_shared<PoolChaines>();
+        GestionnaireUtilisateurs utilisateursPartages(poolChaines);
+        GestionnaireFilms filmsPartages(poolChaines);
+        utilisateursPartages.ajouterUtilisateur(Utilisateur{"a@email.com", "Même Nom", 30, Pays::Canada});
+        utilisateursPartages.ajouterUtilisateur(Utilisateur{"b@email.com", "Même Nom", 40, Pays::France});
+        filmsPartages.ajouterFilm(Film{"Film A", Film::Genre::Drame, Pays::Canada, "Même Nom", 1990});
+        filmsPartages.ajouterFilm(Film{"Film B", Film::Genre::Drame, Pays::Canada, "Même Nom", 1991});
+        GestionnaireUtilisateurs copieUtilisateursPartages(utilisateursPartages);
+        const char* caracteresNom = utilisateursPartages.getUtilisateurParId("a@email.com")->nom.data();
+        tests.push_back(utilisateursPartages.getUtilisateurParId("b@email.com")->nom.data() == caracteresNom &&
+                        filmsPartages.getFilmParNom("Film A")->realisateur.data() == caracteresNom &&
+                        filmsPartages.getFilmParNom("Film B")->realisateur.data() == caracteresNom &&
+                        copieUtilisateursPartages.getUtilisateurParId("a@email.com")->id.data() ==
+                            utilisateursPartages.getUtilisateurParId("a@email.com")->id.data() &&
+                        poolChaines->getNombreChaines() == 3);
+        afficherResultatTest(7, "PoolChaines partagee par les gestionnaires", tests.back());
+
         int nombreTestsReussis = static_cast<int>(std::count(tests.begin(), tests.end(), true));
         double totalPointsSection =
             static_cast<double>(nombreTestsReussis) / static_cast<double>(tests.size()) * maxPointsSection;
@@ -292,9 +343,9 @@ namespace Tests
         // Test 2
         Utilisateur utilisateur{"prénom.nom.@email.com", "Prénom Nom", 20, Pays::Canada};
         Film film{"Nom", Film::Genre::Documentaire, Pays::RoyaumeUni, "Réalisateur", 1970};
-        LigneLog ligneLog1{"2018-01-01T14:54:19Z", &utilisateur, &film};
-        LigneLog ligneLog2{"2018-04-01T14:54:19Z", &utilisateur, &film};
-        const LigneLog ligneLog3{"2018-06-01T14:54:19Z", &utilisateur, &film};
+        LigneLog ligneLog1{*convertirTimestamp("2018-01-01T14:54:19Z"), utilisateur.idDense, film.idDense};
+        LigneLog ligneLog2{*convertirTimestamp("2018-04-01T14:54:19Z"), utilisateur.idDense, film.idDense};
+        const LigneLog ligneLog3{*convertirTimestamp("2018-06-01T14:54:19Z"), utilisateur.idDense, film.idDense};
         ComparateurLog foncteurComparateurLog;
         auto comparaisonLog1 = foncteurComparateurLog(ligneLog1, ligneLog2);
         auto comparaisonLog2 = foncteurComparateurLog(ligneLog2, ligneLog1);
@@ -494,6 +545,326 @@ namespace Tests
         tests.push_back(nombre3 == gestionnaireFilms.getNombreFilms() && nombre4 == 331);
         afficherResultatTest(9, "Chargement et copy ctor toujours fonctionnels", tests.back());
 
+        // Test 10
+        const Film* pointeurFilm21 = gestionnaireFilms.getFilmParNom(film21.nom);
+        gestionnaireFilms.supprimerFilm(film20.nom);
+        gestionnaireFilms.ajouterFilm(film20);
+        const Film* pointeurFilm20 = gestionnaireFilms.getFilmParNom(film20.nom);
+        tests.push_back(pointeurFilm21->idDense == 1 && gestionnaireFilms.getFilmParIdDense(1) == pointeurFilm21 &&
+                        gestionnaireFilms.getFilmParIdDense(0) == nullptr && pointeurFilm20->idDense == 5 &&
+                        gestionnaireFilms.getNombreIdsDenses() == 6 &&
+                        gestionnaireFilms.getFilmParIdDense(idDenseInvalide) == nullptr);
+        afficherResultatTest(10, "GestionnaireFilms::getFilmParIdDense", tests.back());
+
+        // Test 11
+        std::size_t nombreSupprimes =
+            gestionnaireFilms.supprimerFilms({film21.nom, film23.nom, "Inconnu", film21.nom});
+        std::vector<const Film*> filmsRestants = gestionnaireFilms.getFilmsParGenre(Film::Genre::Documentaire);
+        std::vector<const Film*> filmsRestantsAttendus = {gestionnaireFilms.getFilmParNom(film22.nom),
+                                                          gestionnaireFilms.getFilmParNom(film24.nom),
+                                                          pointeurFilm20};
+        tests.push_back(nombreSupprimes == 2 && gestionnaireFilms.getNombreFilms() == 3 &&
+                        gestionnaireFilms.getFilmParNom(film21.nom) == nullptr &&
+                        filmsRestants == filmsRestantsAttendus &&
+                        gestionnaireFilms.getFilmsEntreAnnees(1970, 1970).size() == 3);
+        afficherResultatTest(11, "GestionnaireFilms::supprimerFilms", tests.back());
+
+        // Test 12
+        std::string nomTemporaire = "Film temporaire";
+        gestionnaireFilms.ajouterFilm(Film{nomTemporaire, Film::Genre::Drame, Pays::Canada, "Realisateur", 1999});
+        const Film* pointeurTemporaire = gestionnaireFilms.getFilmParNom("Film temporaire");
+        nomTemporaire.assign(nomTemporaire.size(), '?');
+        bool estNomCopie = pointeurTemporaire != nullptr && pointeurTemporaire->nom == "Film temporaire" &&
+                           pointeurTemporaire->nom.data() != nomTemporaire.data();
+        gestionnaireFilms.supprimerFilm("Film temporaire");
+        gestionnaireFilms.ajouterFilm(film21);
+        tests.push_back(estNomCopie && gestionnaireFilms.getFilmParNom(film21.nom) == pointeurTemporaire &&
+                        pointeurTemporaire->realisateur == film21.realisateur);
+        afficherResultatTest(12, "Pool de films et arene de chaines", tests.back());
+
+        // Test 13
+        GestionnaireFilms gestionnaireFilms3;
+        for (int annee : {2005, 1990, 2005, 1995, 2010, 1990})
+        {
+            std::string nomFilm = "Annee" + std::to_string(annee) + '.' +
+                                  std::to_string(gestionnaireFilms3.getNombreFilms());
+            gestionnaireFilms3.ajouterFilm(Film{nomFilm, Film::Genre::Drame, Pays::France, "Realisateur", annee});
+        }
+        gestionnaireFilms3.supprimerFilm("Annee1995.3");
+        gestionnaireFilms3.supprimerFilms({"Annee2010.4"});
+        const GestionnaireFilms& gestionnaireFilms3Const = gestionnaireFilms3;
+        VueFilms vueFilms = gestionnaireFilms3Const.getVueFilmsEntreAnnees(1990, 2005);
+        std::vector<std::string_view> nomsVue;
+        for (const Film* film : vueFilms)
+        {
+            nomsVue.push_back(film->nom);
+        }
+        std::vector<std::string_view> nomsVueAttendus = {"Annee1990.1", "Annee1990.5", "Annee2005.0", "Annee2005.2"};
+        tests.push_back(nomsVue == nomsVueAttendus &&
+                        gestionnaireFilms3Const.getVueFilmsEntreAnnees(2006, 2020).empty() &&
+                        gestionnaireFilms3Const.getVueFilmsEntreAnnees(2005, 1990).empty() &&
+                        gestionnaireFilms3Const.getFilmsEntreAnnees(1991, 2005).size() == 2);
+        afficherResultatTest(13, "GestionnaireFilms::getVueFilmsEntreAnnees", tests.back());
+
+        // Test 14
+        gestionnaireFilms3.chargerDepuisFichier("films.txt");
+        std::vector<RequeteFilms> requetes(5);
+        requetes[0].genre = Film::Genre::Drame;
+        requetes[0].pays = Pays::France;
+        requetes[1].genre = Film::Genre::Action;
+        requetes[1].anneeDebut = 1990;
+        requetes[1].anneeFin = 2000;
+        requetes[2].pays = Pays::Japon;
+        requetes[2].anneeFin = 1970;
+        requetes[3].realisateur = gestionnaireFilms3.getFilmsEntreAnnees(1960, 1960).front()->realisateur;
+        bool requetesValides = true;
+        for (const RequeteFilms& requete : requetes)
+        {
+            std::vector<const Film*> filmsTrouves = gestionnaireFilms3.getFilms(requete);
+            std::vector<const Film*> filmsAttendus;
+            for (const Film* film : gestionnaireFilms3.getVueFilmsEntreAnnees(INT_MIN, INT_MAX))
+            {
+                if (requete.estSatisfaitePar(*film))
+                {
+                    filmsAttendus.push_back(film);
+                }
+            }
+            std::sort(filmsTrouves.begin(), filmsTrouves.end());
+            std::sort(filmsAttendus.begin(), filmsAttendus.end());
+            requetesValides = requetesValides && !filmsAttendus.empty() && filmsTrouves == filmsAttendus &&
+                              gestionnaireFilms3.compterFilms(requete) == filmsAttendus.size();
+        }
+        tests.push_back(requetesValides && gestionnaireFilms3.compterFilms(RequeteFilms{}) == 331);
+        afficherResultatTest(14, "GestionnaireFilms::rechercherFilms", tests.back());
+
+        // Test 15
+        std::vector<Film::Genre> genres = {Film::Genre::Drame, Film::Genre::Comedie};
+        std::vector<Pays> pays = {Pays::France, Pays::Canada, Pays::Japon};
+        auto trouverFilmsAttendus = [&]() {
+            std::vector<const Film*> filmsAttendus;
+            for (const Film* film : gestionnaireFilms3.getVueFilmsEntreAnnees(INT_MIN, INT_MAX))
+            {
+                if (std::find(genres.begin(), genres.end(), film->genre) != genres.end() &&
+                    std::find(pays.begin(), pays.end(), film->pays) != pays.end())
+                {
+                    filmsAttendus.push_back(film);
+                }
+            }
+            std::sort(filmsAttendus.begin(), filmsAttendus.end(), [](const Film* film1, const Film* film2) {
+                return film1->idDense < film2->idDense;
+            });
+            return filmsAttendus;
+        };
+        std::vector<const Film*> filmsGenresPaysAttendus1 = trouverFilmsAttendus();
+        bool filmsGenresPays1Valides =
+            gestionnaireFilms3.getFilmsParGenresEtPays(genres, pays) == filmsGenresPaysAttendus1 &&
+            gestionnaireFilms3.compterFilmsParGenresEtPays(genres, pays) == filmsGenresPaysAttendus1.size();
+        gestionnaireFilms3.supprimerFilm(filmsGenresPaysAttendus1.front()->nom);
+        std::vector<const Film*> filmsGenresPaysAttendus2 = trouverFilmsAttendus();
+        bool filmsGenresPays2Valides =
+            gestionnaireFilms3.getFilmsParGenresEtPays(genres, pays) == filmsGenresPaysAttendus2 &&
+            filmsGenresPaysAttendus2.size() + 1 == filmsGenresPaysAttendus1.size();
+        tests.push_back(filmsGenresPays1Valides && filmsGenresPays2Valides &&
+                        gestionnaireFilms3.compterFilmsParGenresEtPays({}, {}) == 330 &&
+                        gestionnaireFilms3.getEnsembleFilms({Film::Genre::Drame}, {}).compter() ==
+                            gestionnaireFilms3.getFilmsParGenre(Film::Genre::Drame).size());
+        afficherResultatTest(15, "GestionnaireFilms::getFilmsParGenresEtPays", tests.back());
+
+        // Test 16
+        gestionnaireFilms3.supprimerFilm(gestionnaireFilms3.getFilmsParPays(Pays::Chine).front()->nom);
+        gestionnaireFilms3.supprimerFilm(gestionnaireFilms3.getFilmsParGenre(Film::Genre::Drame)[1]->nom);
+        VueFilms vueDrames = gestionnaireFilms3.getVueFilmsParGenre(Film::Genre::Drame);
+        std::vector<const Film*> drames = gestionnaireFilms3.getFilmsParGenre(Film::Genre::Drame);
+        GestionnaireFilms gestionnaireFilms4(gestionnaireFilms3);
+        auto getNoms = [](VueFilms films) {
+            std::vector<std::string_view> noms;
+            for (const Film* film : films)
+            {
+                noms.push_back(film->nom);
+            }
+            return noms;
+        };
+        tests.push_back(std::vector<const Film*>(vueDrames.begin(), vueDrames.end()) == drames &&
+                        vueDrames.size() == drames.size() &&
+                        getNoms(gestionnaireFilms4.getVueFilmsParPays(Pays::Chine)) ==
+                            getNoms(gestionnaireFilms3.getVueFilmsParPays(Pays::Chine)) &&
+                        getNoms(gestionnaireFilms4.getVueFilmsParGenre(Film::Genre::Drame)) == getNoms(vueDrames) &&
+                        gestionnaireFilms3.getVueFilmsParGenre(static_cast<Film::Genre>(42)).empty());
+        afficherResultatTest(16, "GestionnaireFilms::getVueFilmsParGenre et Pays", tests.back());
+
+        // Test 17
+        static_assert(getGenreString(Film::Genre::ScienceFiction) == "Science-fiction");
+        static_assert(getPaysDepuisString("Royaume-Uni") == Pays::RoyaumeUni);
+        static_assert(!getGenreDepuisString("Inconnu"));
+        bool tablesValides = getGenreString(static_cast<Film::Genre>(42)) == "Erreur" &&
+                             getPaysString(static_cast<Pays>(42)) == "Erreur";
+        for (std::size_t i = 0; i < nombreGenres; i++)
+        {
+            auto genre = static_cast<Film::Genre>(i);
+            tablesValides = tablesValides && getGenreDepuisString(getGenreString(genre)) == genre;
+        }
+        for (std::size_t i = 0; i < nombrePays; i++)
+        {
+            auto unPays = static_cast<Pays>(i);
+            tablesValides = tablesValides && getPaysDepuisString(getPaysString(unPays)) == unPays;
+        }
+        tests.push_back(tablesValides);
+        afficherResultatTest(17, "Tables constexpr des genres et des pays", tests.back());
+
+        // Test 18
+        GestionnaireFilms gestionnaireFilms5;
+        gestionnaireFilms5.ajouterFilm(Film{"Nom, \"Titre\"", Film::Genre::Drame, Pays::Canada, "Réalisateur", 1999});
+        gestionnaireFilms5.ajouterFilm(Film{"Nom2", Film::Genre::Action, Pays::Japon, "A\\B", 2001});
+        std::ostringstream streamCsv;
+        std::ostringstream streamJson;
+        std::ostringstream streamTexte;
+        {
+            RedacteurRapport redacteurCsv(streamCsv, RedacteurRapport::Format::Csv);
+            redacteurCsv.ecrireFilms(gestionnaireFilms5);
+            RedacteurRapport redacteurJson(streamJson, RedacteurRapport::Format::Json, 1);
+            redacteurJson.ecrireFilms(gestionnaireFilms5);
+            RedacteurRapport redacteurTexte(streamTexte, RedacteurRapport::Format::Texte, 1);
+            redacteurTexte.ecrireFilms(gestionnaireFilms5);
+        }
+        std::ostringstream streamOperateur;
+        streamOperateur << gestionnaireFilms5;
+        static const std::string sortieCsvAttendue = "nom,genre,pays,realisateur,annee\n"
+                                                     "\"Nom, \"\"Titre\"\"\",Drame,Canada,Réalisateur,1999\n"
+                                                     "Nom2,Action,Japon,A\\B,2001\n";
+        static const std::string sortieJsonAttendue =
+            "[\n"
+            "{\"nom\":\"Nom, \\\"Titre\\\"\",\"genre\":\"Drame\",\"pays\":\"Canada\",\"realisateur\":\"Réalisateur\","
+            "\"annee\":1999},\n"
+            "{\"nom\":\"Nom2\",\"genre\":\"Action\",\"pays\":\"Japon\",\"realisateur\":\"A\\\\B\",\"annee\":2001}\n"
+            "]\n";
+        tests.push_back(streamCsv.str() == sortieCsvAttendue && streamJson.str() == sortieJsonAttendue &&
+                        streamTexte.str() == streamOperateur.str());
+        afficherResultatTest(18, "RedacteurRapport", tests.back());
+
+        // Test 19
+        const std::string nomInstantaneFilms =
+            (std::filesystem::temp_directory_path() / "tests_films.instantane").string();
+        gestionnaireFilms5.ajouterFilm(Film{"Nom3", Film::Genre::Action, Pays::Canada, "A\\B", 1999});
+        gestionnaireFilms5.supprimerFilm("Nom2");
+        bool sauvegardeFilms = gestionnaireFilms5.sauvegarderInstantane(nomInstantaneFilms);
+        GestionnaireFilms gestionnaireFilms6;
+        gestionnaireFilms6.ajouterFilm(Film{"Autre", Film::Genre::Drame, Pays::Chine, "Autre", 1950});
+        bool chargementFilms = gestionnaireFilms6.chargerInstantane(nomInstantaneFilms);
+        std::remove(nomInstantaneFilms.c_str());
+        const Film* filmCharge = gestionnaireFilms6.getFilmParIdDense(2);
+        tests.push_back(sauvegardeFilms && chargementFilms && gestionnaireFilms6.getNombreFilms() == 2 &&
+                        gestionnaireFilms6.getNombreIdsDenses() == 3 &&
+                        gestionnaireFilms6.getFilmParIdDense(1) == nullptr && filmCharge != nullptr &&
+                        filmCharge->nom == "Nom3" && filmCharge->realisateur == "A\\B" &&
+                        gestionnaireFilms6.getFilmParNom("Autre") == nullptr &&
+                        getNoms(gestionnaireFilms6.getVueFilmsEntreAnnees(1990, 2010)) ==
+                            getNoms(gestionnaireFilms5.getVueFilmsEntreAnnees(1990, 2010)) &&
+                        gestionnaireFilms6.compterFilmsParGenresEtPays({Film::Genre::Action}, {Pays::Canada}) == 1);
+        afficherResultatTest(19, "GestionnaireFilms instantane binaire", tests.back());
+
+        // Test 20
+        GestionnaireFilms copieFilms = gestionnaireFilms5;
+        const Film* filmPartage = copieFilms.getFilmParNom("Nom3");
+        bool copiePartagee = filmPartage != nullptr && filmPartage == gestionnaireFilms5.getFilmParNom("Nom3");
+        std::atomic<bool> copieStable = true;
+        std::thread lecteurCopie(
+            [&copieFilms, &copieStable, &getNoms]()
+            {
+                for (int i = 0; i < 200; i++)
+                {
+                    const Film* film = copieFilms.getFilmParNom("Nom3");
+                    bool stable = copieFilms.getNombreFilms() == 2 && film != nullptr && film->realisateur == "A\\B" &&
+                                  copieFilms.getVueFilmsParGenre(Film::Genre::Action).size() == 1 &&
+                                  getNoms(copieFilms.getVueFilmsEntreAnnees(1990, 2010)).size() == 2;
+                    copieStable = copieStable && stable;
+                }
+            });
+        for (int i = 0; i < 200; i++)
+        {
+            gestionnaireFilms5.ajouterFilm(
+                Film{"Copie" + std::to_string(i), Film::Genre::Action, Pays::Canada, "Réalisateur", 2000 + i % 10});
+        }
+        gestionnaireFilms5.supprimerFilm("Nom3");
+        gestionnaireFilms5.supprimerFilms({"Copie0", "Copie1"});
+        lecteurCopie.join();
+        copieFilms.supprimerFilm("Nom, \"Titre\"");
+        tests.push_back(copiePartagee && copieStable && copieFilms.getNombreFilms() == 1 &&
+                        copieFilms.getFilmParNom("Nom3") == filmPartage && filmPartage->nom == "Nom3" &&
+                        copieFilms.getFilmParNom("Copie5") == nullptr && gestionnaireFilms5.getNombreFilms() == 199 &&
+                        gestionnaireFilms5.getFilmParNom("Nom3") == nullptr &&
+                        gestionnaireFilms5.getFilmParNom("Nom, \"Titre\"") != nullptr);
+        afficherResultatTest(20, "GestionnaireFilms copie sur ecriture", tests.back());
+
+        // Test 21
+        GestionnaireFilms filmsRecycles;
+        for (int i = 0; i < 2; i++)
+        {
+            filmsRecycles.ajouterFilm(
+                Film{"Recycle" + std::to_string(i), Film::Genre::Drame, Pays::France, "Réalisateur", 2000});
+        }
+        const Film* filmRecycle = filmsRecycles.getFilmParNom("Recycle0");
+        bool instantaneIntact;
+        {
+            // Le film supprimé reste lisible par l'instantané
+            GestionnaireFilms instantaneRecycle = filmsRecycles;
+            filmsRecycles.supprimerFilm("Recycle0");
+            filmsRecycles.ajouterFilm(Film{"Recycle2", Film::Genre::Drame, Pays::France, "Réalisateur", 2000});
+            instantaneIntact = instantaneRecycle.getFilmParNom("Recycle0") == filmRecycle &&
+                               filmRecycle->nom == "Recycle0" && instantaneRecycle.getNombreFilms() == 2;
+        }
+        // Sans instantané, les segments sont absorbés et l'emplacement du film supprimé est réutilisé
+        filmsRecycles.ajouterFilm(Film{"Recycle3", Film::Genre::Drame, Pays::France, "Réalisateur", 2000});
+        tests.push_back(instantaneIntact && filmsRecycles.getFilmParNom("Recycle3") == filmRecycle &&
+                        filmsRecycles.getNombreFilms() == 3 && filmsRecycles.getFilmParNom("Recycle2") != nullptr &&
+                        filmsRecycles.getFilmParNom("Recycle2")->nom == "Recycle2");
+        afficherResultatTest(21, "GestionnaireFilms recyclage des segments", tests.back());
+
+        // Test 22
+        const std::string nomFichierFilmsInvalides =
+            (std::filesystem::temp_directory_path() / "tests_films_invalides.txt").string();
+        std::ofstream(nomFichierFilmsInvalides, std::ios::binary)
+            << "\"Valide\" 0 2 \"Réalisateur\" 1970\n"
+            << "\"Genre invalide\" 12 2 \"Réalisateur\" 1970\n"
+            << "\"Pays invalide\" 0 -1 \"Réalisateur\" 1970\n";
+        GestionnaireFilms filmsInvalides;
+        bool chargementInvalide = filmsInvalides.chargerDepuisFichier(nomFichierFilmsInvalides);
+        std::remove(nomFichierFilmsInvalides.c_str());
+        bool ajoutGenreInvalide = filmsInvalides.ajouterFilm(
+            Film{"Genre 9", static_cast<Film::Genre>(nombreGenres), Pays::Canada, "Réalisateur", 2000});
+        bool ajoutPaysInvalide = filmsInvalides.ajouterFilm(
+            Film{"Pays 9", Film::Genre::Action, static_cast<Pays>(nombrePays), "Réalisateur", 2000});
+        RequeteFilms requeteInvalide;
+        requeteInvalide.genre = static_cast<Film::Genre>(12);
+        requeteInvalide.pays = Pays::Canada;
+        tests.push_back(!chargementInvalide && filmsInvalides.getNombreFilms() == 1 &&
+                        filmsInvalides.getFilmParNom("Valide") != nullptr && !ajoutGenreInvalide &&
+                        !ajoutPaysInvalide && filmsInvalides.getNombreFilms() == 1 &&
+                        filmsInvalides.compterFilms(requeteInvalide) == 0 &&
+                        filmsInvalides.compterFilmsParGenresEtPays({static_cast<Film::Genre>(12)}, {}) == 0);
+        afficherResultatTest(22, "GestionnaireFilms genres et pays hors de l'enum", tests.back());
+
+        // Test 23
+        Film copieFilm;
+        std::string_view vueRealisateur;
+        {
+            GestionnaireFilms filmsTemporaires;
+            filmsTemporaires.ajouterFilm(Film{"Premier", Film::Genre::Drame, Pays::France, "Réalisateur 1", 1990});
+            filmsTemporaires.ajouterFilm(Film{"Second", Film::Genre::Drame, Pays::France, "Réalisateur 2", 1991});
+            copieFilm = *filmsTemporaires.getFilmParNom("Second");
+            vueRealisateur = copieFilm.realisateur;
+        }
+        ArenaChaines arene(64, 16);
+        ChaineArena chaine1 = arene.ajouter("0123456789");
+        ChaineArena chaine2 = arene.ajouter("abc");
+        ChaineArena chaine3 = arene.ajouter(std::string(32, 'x'));
+        std::size_t nombreBlocsArene = arene.getNombreBlocs();
+        ChaineArena chaine4 = arene.ajouter("defg");
+        tests.push_back(copieFilm.nom == "Second" && vueRealisateur == "Réalisateur 2" &&
+                        chaine2.data() == chaine1.data() + chaine1.size() && chaine3 == std::string(32, 'x') &&
+                        nombreBlocsArene == 2 && arene.getNombreBlocs() == 3 && chaine4 == "defg" &&
+                        chaine1 != chaine2 && arene.ajouter("").empty());
+        afficherResultatTest(23, "ArenaChaines duree de vie des chaines", tests.back());
+
         int nombreTestsReussis = static_cast<int>(std::count(tests.begin(), tests.end(), true));
         double totalPointsSection =
             static_cast<double>(nombreTestsReussis) / static_cast<double>(tests.size()) * maxPointsSection;
@@ -518,22 +889,26 @@ namespace Tests
         GestionnaireUtilisateurs gestionnaireUtilisateurs;
         static constexpr std::size_t nombreUtilisateurs = 10;
         std::array<const Utilisateur*, nombreUtilisateurs> pointeursUtilisateurs;
+        std::array<IdDense, nombreUtilisateurs> idsUtilisateurs;
         for (std::size_t i = 0; i < nombreUtilisateurs; i++)
         {
             std::string idUtilisateur = "prénom.nom." + std::to_string(i + 1) + "@email.com";
             gestionnaireUtilisateurs.ajouterUtilisateur(Utilisateur{idUtilisateur, "Prénom Nom", 20, Pays::Canada});
             pointeursUtilisateurs[i] = gestionnaireUtilisateurs.getUtilisateurParId(idUtilisateur);
+            idsUtilisateurs[i] = pointeursUtilisateurs[i]->idDense;
         }
 
         GestionnaireFilms gestionnaireFilms;
         static constexpr std::size_t nombreFilms = 10;
         std::array<const Film*, nombreFilms> pointeursFilms;
+        std::array<IdDense, nombreFilms> idsFilms;
         for (std::size_t i = 0; i < nombreFilms; i++)
         {
             std::string nomFilm = "Nom" + std::to_string(i + 1);
             gestionnaireFilms.ajouterFilm(
                 Film{nomFilm, Film::Genre::Documentaire, Pays::RoyaumeUni, "Réalisateur", 1970});
             pointeursFilms[i] = gestionnaireFilms.getFilmParNom(nomFilm);
+            idsFilms[i] = pointeursFilms[i]->idDense;
         }
 
         AnalyseurLogs analyseurLogs;
@@ -559,36 +934,36 @@ namespace Tests
 
         // Test 2
         std::vector<LigneLog> logsAjoutes = {
-            LigneLog{"2018-01-01T00:00:00Z", pointeursUtilisateurs[3], pointeursFilms[4]},
-            LigneLog{"2018-01-01T12:00:00Z", pointeursUtilisateurs[3], pointeursFilms[4]},
-            LigneLog{"2018-01-01T11:00:00Z", pointeursUtilisateurs[0], pointeursFilms[4]},
-            LigneLog{"2018-01-01T10:00:00Z", pointeursUtilisateurs[1], pointeursFilms[4]},
-            LigneLog{"2018-01-01T09:00:00Z", pointeursUtilisateurs[2], pointeursFilms[4]},
-            LigneLog{"2018-01-01T08:00:00Z", pointeursUtilisateurs[3], pointeursFilms[8]},
-            LigneLog{"2018-01-01T07:00:00Z", pointeursUtilisateurs[4], pointeursFilms[8]},
-            LigneLog{"2018-01-01T06:00:00Z", pointeursUtilisateurs[5], pointeursFilms[8]},
-            LigneLog{"2018-01-01T05:00:00Z", pointeursUtilisateurs[6], pointeursFilms[9]},
-            LigneLog{"2018-01-01T04:00:00Z", pointeursUtilisateurs[7], pointeursFilms[9]},
-            LigneLog{"2018-01-01T03:00:00Z", pointeursUtilisateurs[8], pointeursFilms[0]},
-            LigneLog{"2018-01-01T02:00:00Z", pointeursUtilisateurs[9], pointeursFilms[1]},
-            LigneLog{"2018-01-01T01:00:00Z", pointeursUtilisateurs[1], pointeursFilms[2]},
-            LigneLog{"2018-01-01T01:00:00Z", pointeursUtilisateurs[1], pointeursFilms[3]},
-            LigneLog{"2018-01-01T01:00:00Z", pointeursUtilisateurs[1], pointeursFilms[4]},
-            LigneLog{"2019-01-01T01:00:00Z", pointeursUtilisateurs[3], pointeursFilms[5]},
-            LigneLog{"2020-01-01T01:00:00Z", pointeursUtilisateurs[3], pointeursFilms[6]},
-            LigneLog{"2019-05-01T01:00:00Z", pointeursUtilisateurs[3], pointeursFilms[7]},
-            LigneLog{"2020-05-01T01:00:00Z", pointeursUtilisateurs[3], pointeursFilms[8]},
-            LigneLog{"2019-03-01T01:00:00Z", pointeursUtilisateurs[1], pointeursFilms[9]},
+            LigneLog{*convertirTimestamp("2018-01-01T00:00:00Z"), idsUtilisateurs[3], idsFilms[4]},
+            LigneLog{*convertirTimestamp("2018-01-01T12:00:00Z"), idsUtilisateurs[3], idsFilms[4]},
+            LigneLog{*convertirTimestamp("2018-01-01T11:00:00Z"), idsUtilisateurs[0], idsFilms[4]},
+            LigneLog{*convertirTimestamp("2018-01-01T10:00:00Z"), idsUtilisateurs[1], idsFilms[4]},
+            LigneLog{*convertirTimestamp("2018-01-01T09:00:00Z"), idsUtilisateurs[2], idsFilms[4]},
+            LigneLog{*convertirTimestamp("2018-01-01T08:00:00Z"), idsUtilisateurs[3], idsFilms[8]},
+            LigneLog{*convertirTimestamp("2018-01-01T07:00:00Z"), idsUtilisateurs[4], idsFilms[8]},
+            LigneLog{*convertirTimestamp("2018-01-01T06:00:00Z"), idsUtilisateurs[5], idsFilms[8]},
+            LigneLog{*convertirTimestamp("2018-01-01T05:00:00Z"), idsUtilisateurs[6], idsFilms[9]},
+            LigneLog{*convertirTimestamp("2018-01-01T04:00:00Z"), idsUtilisateurs[7], idsFilms[9]},
+            LigneLog{*convertirTimestamp("2018-01-01T03:00:00Z"), idsUtilisateurs[8], idsFilms[0]},
+            LigneLog{*convertirTimestamp("2018-01-01T02:00:00Z"), idsUtilisateurs[9], idsFilms[1]},
+            LigneLog{*convertirTimestamp("2018-01-01T01:00:00Z"), idsUtilisateurs[1], idsFilms[2]},
+            LigneLog{*convertirTimestamp("2018-01-01T01:00:00Z"), idsUtilisateurs[1], idsFilms[3]},
+            LigneLog{*convertirTimestamp("2018-01-01T01:00:00Z"), idsUtilisateurs[1], idsFilms[4]},
+            LigneLog{*convertirTimestamp("2019-01-01T01:00:00Z"), idsUtilisateurs[3], idsFilms[5]},
+            LigneLog{*convertirTimestamp("2020-01-01T01:00:00Z"), idsUtilisateurs[3], idsFilms[6]},
+            LigneLog{*convertirTimestamp("2019-05-01T01:00:00Z"), idsUtilisateurs[3], idsFilms[7]},
+            LigneLog{*convertirTimestamp("2020-05-01T01:00:00Z"), idsUtilisateurs[3], idsFilms[8]},
+            LigneLog{*convertirTimestamp("2019-03-01T01:00:00Z"), idsUtilisateurs[1], idsFilms[9]},
         };
-        analyseurLogs.logs_.clear();
+        analyseurLogs.logs_.vider();
         for (const auto& ligneLog : logsAjoutes)
         {
-            analyseurLogs.ajouterLigneLog(ligneLog);
+            analyseurLogs.ajouterLigneLog(ligneLog, gestionnaireUtilisateurs, gestionnaireFilms);
         }
         bool logsSontOrdonnes =
-            std::is_sorted(analyseurLogs.logs_.begin(), analyseurLogs.logs_.end(), ComparateurLog());
-        int nombreVuesFilm1 = analyseurLogs.vuesFilms_[pointeursFilms[4]];
-        int nombreVuesFilm2 = analyseurLogs.vuesFilms_[pointeursFilms[5]];
+            std::is_sorted(analyseurLogs.logs_.getTimestamps().begin(), analyseurLogs.logs_.getTimestamps().end());
+        int nombreVuesFilm1 = analyseurLogs.vuesFilms_[idsFilms[4]];
+        int nombreVuesFilm2 = analyseurLogs.vuesFilms_[idsFilms[5]];
         tests.push_back(logsSontOrdonnes && nombreVuesFilm1 == 6 && nombreVuesFilm2 == 1);
         afficherResultatTest(2, "AnalyseurLogs::ajouterLigneLog", tests.back());
 
@@ -649,6 +1024,482 @@ namespace Tests
         tests.push_back(filmsVus1.empty() && filmsVus2.empty() && filmsVus3 == filmsVus3Attendus && filmsVus4.empty());
         afficherResultatTest(7, "AnalyseurLogs::getFilmsVusParUtilisateur", tests.back());
 
+        // Test 8
+        Timestamp debutJournee = *convertirTimestamp("2018-01-01T00:00:00Z");
+        Timestamp finJournee = *convertirTimestamp("2018-01-01T12:00:00Z");
+        Timestamp debut2019 = *convertirTimestamp("2019-01-01T00:00:00Z");
+        Timestamp fin2019 = *convertirTimestamp("2019-12-31T23:59:59Z");
+        int nombreVuesEntre1 = analyseurLogs.getNombreVuesFilmEntre(pointeursFilms[4], debutJournee, finJournee);
+        int nombreVuesEntre2 = analyseurLogs.getNombreVuesFilmEntre(pointeursFilms[8], debutJournee, finJournee);
+        int nombreVuesEntre3 = analyseurLogs.getNombreVuesFilmEntre(pointeursFilms[5], debut2019, fin2019);
+        int nombreVuesEntre4 = analyseurLogs.getNombreVuesFilmEntre(pointeursFilms[4], finJournee, debutJournee);
+        int nombreVuesUtilisateurEntre =
+            analyseurLogs.getNombreVuesPourUtilisateurEntre(pointeursUtilisateurs[1], debutJournee, finJournee);
+        std::vector<std::pair<const Film*, int>> filmsPlusPopulairesEntre =
+            analyseurLogs.getNFilmsPlusPopulairesEntre(2, debutJournee, finJournee);
+        std::vector<std::pair<const Film*, int>> filmsPlusPopulairesEntreAttendus = {
+            std::pair<const Film*, int>(pointeursFilms[4], 6),
+            std::pair<const Film*, int>(pointeursFilms[8], 3),
+        };
+        tests.push_back(nombreVuesEntre1 == 6 && nombreVuesEntre2 == 3 && nombreVuesEntre3 == 1 &&
+                        nombreVuesEntre4 == 0 && nombreVuesUtilisateurEntre == 4 &&
+                        filmsPlusPopulairesEntre == filmsPlusPopulairesEntreAttendus);
+        afficherResultatTest(8, "AnalyseurLogs statistiques entre deux moments", tests.back());
+
+        // Test 9
+        GestionnaireUtilisateurs gestionnaireUtilisateursFichier;
+        gestionnaireUtilisateursFichier.chargerDepuisFichier("utilisateurs.txt");
+        GestionnaireFilms gestionnaireFilmsFichier;
+        gestionnaireFilmsFichier.chargerDepuisFichier("films.txt");
+        AnalyseurLogs analyseurLogsSequentiel;
+        analyseurLogsSequentiel.setNombreThreads(1);
+        bool chargement1 = analyseurLogsSequentiel.chargerDepuisFichier("logs.txt",
+                                                                        gestionnaireUtilisateursFichier,
+                                                                        gestionnaireFilmsFichier);
+        AnalyseurLogs analyseurLogsParallele;
+        analyseurLogsParallele.setNombreThreads(4);
+        bool chargement2 = analyseurLogsParallele.chargerDepuisFichier("logs.txt",
+                                                                       gestionnaireUtilisateursFichier,
+                                                                       gestionnaireFilmsFichier);
+        const JournalLogs& logsSequentiels = analyseurLogsSequentiel.logs_;
+        const JournalLogs& logsParalleles = analyseurLogsParallele.logs_;
+        bool logsIdentiques = logsSequentiels.getTimestamps() == logsParalleles.getTimestamps() &&
+                              logsSequentiels.getIdsUtilisateurs() == logsParalleles.getIdsUtilisateurs() &&
+                              logsSequentiels.getIdsFilms() == logsParalleles.getIdsFilms();
+        tests.push_back(chargement1 && chargement2 && logsSequentiels.getTaille() == 9999 &&
+                        logsIdentiques && analyseurLogsSequentiel.vuesFilms_ == analyseurLogsParallele.vuesFilms_);
+        afficherResultatTest(9, "AnalyseurLogs::chargerDepuisFichier multithread", tests.back());
+
+        // Test 10
+        std::optional<Timestamp> timestamp1 = convertirTimestamp("1970-01-01T00:00:00Z");
+        std::optional<Timestamp> timestamp2 = convertirTimestamp("2016-02-29T17:12:49Z");
+        std::optional<Timestamp> timestamp3 = convertirTimestamp("2015-02-29T17:12:49Z");
+        std::optional<Timestamp> timestamp4 = convertirTimestamp("2016-04-29 17:12:49");
+        tests.push_back(timestamp1 == 0 && timestamp2 == 1456765969 && !timestamp3 && !timestamp4 &&
+                        getTimestampString(*timestamp2) == "2016-02-29T17:12:49Z" &&
+                        getTimestampString(-1) == "1969-12-31T23:59:59Z");
+        afficherResultatTest(10, "Conversion des timestamps", tests.back());
+
+        // Test 11
+        AnalyseurLogs analyseurLogsLot;
+        analyseurLogsLot.ajouterLigneLog(
+            LigneLog{*convertirTimestamp("2018-01-01T05:00:00Z"), idsUtilisateurs[0], idsFilms[0]},
+            gestionnaireUtilisateurs,
+            gestionnaireFilms);
+        std::vector<LigneLog> lot1 = {
+            LigneLog{*convertirTimestamp("2018-01-01T06:00:00Z"), idsUtilisateurs[1], idsFilms[1]},
+            LigneLog{*convertirTimestamp("2018-01-01T05:00:00Z"), idsUtilisateurs[2], idsFilms[1]},
+            LigneLog{*convertirTimestamp("2018-01-01T04:00:00Z"), idsUtilisateurs[3], idsFilms[2]},
+        };
+        std::vector<LigneLog> lot2 = {
+            LigneLog{*convertirTimestamp("2018-01-01T07:00:00Z"), idDenseInvalide, idsFilms[0]},
+        };
+        bool ajoutLot1 = analyseurLogsLot.ajouterLignesLog(lot1, gestionnaireUtilisateurs, gestionnaireFilms);
+        bool ajoutLot2 = analyseurLogsLot.ajouterLignesLog(lot2, gestionnaireUtilisateurs, gestionnaireFilms);
+        std::vector<IdDense> idsUtilisateursAttendus = {idsUtilisateurs[3],
+                                                        idsUtilisateurs[0],
+                                                        idsUtilisateurs[2],
+                                                        idsUtilisateurs[1]};
+        std::vector<IdDense> idsFilmsAttendus = {idsFilms[2], idsFilms[0], idsFilms[1], idsFilms[1]};
+        tests.push_back(ajoutLot1 && !ajoutLot2 &&
+                        analyseurLogsLot.logs_.getIdsUtilisateurs() == idsUtilisateursAttendus &&
+                        analyseurLogsLot.logs_.getIdsFilms() == idsFilmsAttendus &&
+                        analyseurLogsLot.getNombreVuesFilm(pointeursFilms[1]) == 2);
+        afficherResultatTest(11, "AnalyseurLogs::ajouterLignesLog", tests.back());
+
+        // Test 12
+        std::vector<IdDense> cles(1003);
+        for (std::size_t i = 0; i < cles.size(); i++)
+        {
+            cles[i] = static_cast<IdDense>(i * i % 7);
+        }
+        bool comptagesIdentiques = true;
+        for (NoyauxComptage::Implementation implementation : {NoyauxComptage::Implementation::Scalaire,
+                                                              NoyauxComptage::Implementation::Sse2,
+                                                              NoyauxComptage::Implementation::Avx2})
+        {
+            for (std::size_t nombreCles : {std::size_t{0}, std::size_t{5}, cles.size()})
+            {
+                for (IdDense cle = 0; cle < 8; cle++)
+                {
+                    auto nombreAttendu = std::count(cles.begin(), std::next(cles.begin(), nombreCles), cle);
+                    comptagesIdentiques =
+                        comptagesIdentiques &&
+                        NoyauxComptage::compterEgaux(cles.data(), nombreCles, cle, implementation) ==
+                            static_cast<std::size_t>(nombreAttendu);
+                }
+            }
+        }
+        std::vector<int> histogramme(7, 0);
+        NoyauxComptage::accumulerHistogramme(cles.data(), cles.size(), histogramme);
+        bool histogrammeValide = true;
+        for (IdDense cle = 0; cle < histogramme.size(); cle++)
+        {
+            histogrammeValide =
+                histogrammeValide && histogramme[cle] == std::count(cles.begin(), cles.end(), cle);
+        }
+        tests.push_back(comptagesIdentiques && histogrammeValide);
+        afficherResultatTest(12, "Noyaux de comptage vectoriels", tests.back());
+
+        // Test 13
+        const std::filesystem::path dossierInstantanes = std::filesystem::temp_directory_path();
+        const std::string nomInstantaneUtilisateurs = (dossierInstantanes / "tests_utilisateurs.instantane").string();
+        const std::string nomInstantaneFilms = (dossierInstantanes / "tests_films.instantane").string();
+        const std::string nomInstantaneLogs = (dossierInstantanes / "tests_logs.instantane").string();
+        bool sauvegardes = gestionnaireUtilisateursFichier.sauvegarderInstantane(nomInstantaneUtilisateurs) &&
+                           gestionnaireFilmsFichier.sauvegarderInstantane(nomInstantaneFilms) &&
+                           analyseurLogsSequentiel.sauvegarderInstantane(nomInstantaneLogs);
+        GestionnaireUtilisateurs gestionnaireUtilisateursInstantane;
+        GestionnaireFilms gestionnaireFilmsInstantane;
+        AnalyseurLogs analyseurLogsInstantane;
+        bool chargements =
+            gestionnaireUtilisateursInstantane.chargerInstantane(nomInstantaneUtilisateurs) &&
+            gestionnaireFilmsInstantane.chargerInstantane(nomInstantaneFilms) &&
+            analyseurLogsInstantane.chargerInstantane(nomInstantaneLogs,
+                                                      gestionnaireUtilisateursInstantane,
+                                                      gestionnaireFilmsInstantane);
+
+        auto getNomsFilmsVus = [](const AnalyseurLogs& analyseur, const Utilisateur* utilisateur) {
+            std::vector<std::string_view> noms;
+            for (const Film* film : analyseur.getFilmsVusParUtilisateur(utilisateur))
+            {
+                noms.push_back(film->nom);
+            }
+            std::sort(noms.begin(), noms.end());
+            return noms;
+        };
+        bool resultatsIdentiques =
+            gestionnaireUtilisateursInstantane.getNombreIdsDenses() ==
+                gestionnaireUtilisateursFichier.getNombreIdsDenses() &&
+            analyseurLogsInstantane.logs_.getTimestamps() == analyseurLogsSequentiel.logs_.getTimestamps() &&
+            analyseurLogsInstantane.getFilmPlusPopulaire()->nom == analyseurLogsSequentiel.getFilmPlusPopulaire()->nom;
+        for (IdDense idDense = 0; idDense < gestionnaireUtilisateursFichier.getNombreIdsDenses(); idDense++)
+        {
+            const Utilisateur* utilisateurFichier = gestionnaireUtilisateursFichier.getUtilisateurParIdDense(idDense);
+            const Utilisateur* utilisateurInstantane =
+                gestionnaireUtilisateursInstantane.getUtilisateurParIdDense(idDense);
+            resultatsIdentiques =
+                resultatsIdentiques && utilisateurInstantane->id == utilisateurFichier->id &&
+                analyseurLogsInstantane.getNombreVuesPourUtilisateur(utilisateurInstantane) ==
+                    analyseurLogsSequentiel.getNombreVuesPourUtilisateur(utilisateurFichier) &&
+                getNomsFilmsVus(analyseurLogsInstantane, utilisateurInstantane) ==
+                    getNomsFilmsVus(analyseurLogsSequentiel, utilisateurFichier);
+        }
+        for (IdDense idDense = 0; idDense < gestionnaireFilmsFichier.getNombreIdsDenses(); idDense++)
+        {
+            const Film* filmFichier = gestionnaireFilmsFichier.getFilmParIdDense(idDense);
+            const Film* filmInstantane = gestionnaireFilmsInstantane.getFilmParIdDense(idDense);
+            resultatsIdentiques = resultatsIdentiques && filmInstantane->nom == filmFichier->nom &&
+                                  analyseurLogsInstantane.getNombreVuesFilm(filmInstantane) ==
+                                      analyseurLogsSequentiel.getNombreVuesFilm(filmFichier);
+        }
+
+        // Un octet modifié doit être détecté par la somme de contrôle
+        {
+            std::fstream fichierInstantane(nomInstantaneFilms, std::ios::in | std::ios::out | std::ios::binary);
+            fichierInstantane.seekp(100);
+            fichierInstantane.put('\x7f');
+        }
+        bool chargementCorrompu = gestionnaireFilmsInstantane.chargerInstantane(nomInstantaneFilms);
+        std::remove(nomInstantaneUtilisateurs.c_str());
+        std::remove(nomInstantaneFilms.c_str());
+        std::remove(nomInstantaneLogs.c_str());
+        tests.push_back(sauvegardes && chargements && resultatsIdentiques && !chargementCorrompu &&
+                        gestionnaireFilmsInstantane.getNombreFilms() == 0);
+        afficherResultatTest(13, "Instantanes binaires des gestionnaires et logs", tests.back());
+
+        // Test 14
+        std::ifstream fichierLogs("logs.txt", std::ios::binary);
+        const std::string texteLogs((std::istreambuf_iterator<char>(fichierLogs)), std::istreambuf_iterator<char>());
+        const std::string nomFichierSuivi = (dossierInstantanes / "tests_logs_suivis.txt").string();
+        std::size_t coupure = texteLogs.size() / 2; // Au milieu d'une ligne, qui ne doit être lue qu'au complet
+        std::ofstream(nomFichierSuivi, std::ios::binary) << texteLogs.substr(0, coupure);
+        AnalyseurLogs analyseurLogsSuivi;
+        bool suivi1 = analyseurLogsSuivi.suivreFichier(nomFichierSuivi,
+                                                       gestionnaireUtilisateursFichier,
+                                                       gestionnaireFilmsFichier);
+        bool lignesPartielles = analyseurLogsSuivi.logs_.getTaille() > 0 &&
+                                analyseurLogsSuivi.logs_.getTaille() < logsSequentiels.getTaille();
+        std::ofstream(nomFichierSuivi, std::ios::binary | std::ios::app) << texteLogs.substr(coupure);
+        bool suivi2 = analyseurLogsSuivi.suivreFichier(nomFichierSuivi,
+                                                       gestionnaireUtilisateursFichier,
+                                                       gestionnaireFilmsFichier);
+        bool suivi3 = analyseurLogsSuivi.suivreFichier(nomFichierSuivi,
+                                                       gestionnaireUtilisateursFichier,
+                                                       gestionnaireFilmsFichier);
+        std::remove(nomFichierSuivi.c_str());
+        tests.push_back(suivi1 && suivi2 && suivi3 && lignesPartielles &&
+                        analyseurLogsSuivi.logs_.getTimestamps() == logsSequentiels.getTimestamps() &&
+                        analyseurLogsSuivi.logs_.getIdsFilms() == logsSequentiels.getIdsFilms() &&
+                        analyseurLogsSuivi.vuesFilms_ == analyseurLogsSequentiel.vuesFilms_ &&
+                        analyseurLogsSuivi.getFilmPlusPopulaire() == analyseurLogsSequentiel.getFilmPlusPopulaire());
+        afficherResultatTest(14, "AnalyseurLogs::suivreFichier", tests.back());
+
+        // Test 15
+        AnalyseurLogs analyseurLogsRetard;
+        analyseurLogsRetard.setRetardMaximal(3600);
+        Timestamp debutRetard = *convertirTimestamp("2018-01-01T00:00:00Z");
+        for (Timestamp decalage : {0, 600, 300, 1800, 1200, 5400, 4000, 7200, 100, 9000})
+        {
+            analyseurLogsRetard.ajouterLigneLog(LigneLog{debutRetard + decalage, idsUtilisateurs[0], idsFilms[0]},
+                                                gestionnaireUtilisateurs,
+                                                gestionnaireFilms);
+        }
+        const std::vector<Timestamp>& timestampsRetard = analyseurLogsRetard.logs_.getTimestamps();
+        bool lignesRetenues = analyseurLogsRetard.logs_.getTaille() == 7 &&
+                              analyseurLogsRetard.getNombreLignesEnAttente() == 3 &&
+                              analyseurLogsRetard.getNombreLignesEnRetard() == 1 &&
+                              std::is_sorted(timestampsRetard.begin(), timestampsRetard.end());
+        bool lignesComptees =
+            analyseurLogsRetard.getNombreVuesFilmEntre(pointeursFilms[0], debutRetard, debutRetard + 9000) == 10 &&
+            analyseurLogsRetard.getNombreVuesFilmEntre(pointeursFilms[0], debutRetard, debutRetard + 100) == 2 &&
+            analyseurLogsRetard.getNombreVuesPourUtilisateurEntre(
+                pointeursUtilisateurs[0], debutRetard + 7000, debutRetard + 9000) == 2;
+        analyseurLogsRetard.publierLignesEnAttente();
+        tests.push_back(lignesRetenues && lignesComptees && analyseurLogsRetard.logs_.getTaille() == 10 &&
+                        analyseurLogsRetard.getNombreLignesEnAttente() == 0 &&
+                        std::is_sorted(timestampsRetard.begin(), timestampsRetard.end()));
+        afficherResultatTest(15, "AnalyseurLogs lignes en attente et en retard", tests.back());
+
+        // Test 16
+        AnalyseurLogs analyseurLogsConcurrent;
+        analyseurLogsConcurrent.activerPublication();
+        const Timestamp premierTimestamp = logsSequentiels.getTimestamps().front();
+        const Timestamp dernierTimestamp = logsSequentiels.getTimestamps().back();
+        std::atomic<bool> ajoutTermine = false;
+        std::vector<char> lecturesCoherentes(4, true);
+        std::vector<std::thread> threadsLecteurs;
+        for (std::size_t i = 0; i < lecturesCoherentes.size(); i++)
+        {
+            threadsLecteurs.emplace_back([&, i, lecteur = std::move(*analyseurLogsConcurrent.creerLecteur())]() {
+                std::size_t nombreLignesPrecedent = 0;
+                do
+                {
+                    // Une lecture déchirée donnerait des compteurs d'une version et des lignes d'une autre
+                    auto [nombreLignes, coherente] = lecteur.lire([&](const StatistiquesLogs& statistiques) {
+                        std::size_t sommeVues = 0;
+                        for (const auto& [film, nombreVues] :
+                             statistiques.getNFilmsPlusPopulaires(std::numeric_limits<std::size_t>::max()))
+                        {
+                            sommeVues += static_cast<std::size_t>(nombreVues);
+                        }
+                        const Film* filmPopulaire = statistiques.getFilmPlusPopulaire();
+                        bool vuesIdentiques = statistiques.getNombreVuesFilmEntre(
+                                                  filmPopulaire, premierTimestamp, dernierTimestamp) ==
+                                              statistiques.getNombreVuesFilm(filmPopulaire);
+                        return std::make_pair(statistiques.getNombreLignes(),
+                                              vuesIdentiques && sommeVues == statistiques.getNombreLignes());
+                    });
+                    lecturesCoherentes[i] = lecturesCoherentes[i] && coherente && nombreLignes >= nombreLignesPrecedent;
+                    nombreLignesPrecedent = nombreLignes;
+                } while (!ajoutTermine);
+            });
+        }
+        // Les lots sont ajoutés du plus récent au plus ancien pour que les segments publiés se chevauchent
+        constexpr std::size_t tailleLotConcurrent = 97;
+        for (std::size_t fin = logsSequentiels.getTaille(); fin > 0;)
+        {
+            std::size_t debut = fin - std::min(fin, tailleLotConcurrent);
+            std::vector<LigneLog> lot;
+            for (std::size_t j = debut; j < fin; j++)
+            {
+                lot.push_back(logsSequentiels.getLigneLog(j));
+            }
+            analyseurLogsConcurrent.ajouterLignesLog(std::move(lot), gestionnaireUtilisateursFichier,
+                                                     gestionnaireFilmsFichier);
+            fin = debut;
+        }
+        ajoutTermine = true;
+        for (std::thread& thread : threadsLecteurs)
+        {
+            thread.join();
+        }
+        std::optional<PublicationEpoques<StatistiquesLogs>::Lecteur> lecteurFinal =
+            analyseurLogsConcurrent.creerLecteur();
+        bool versionFinale = lecteurFinal && lecteurFinal->lire([&](const StatistiquesLogs& statistiques) {
+            const Film* filmPopulaire = statistiques.getFilmPlusPopulaire();
+            return statistiques.getNombreLignes() == logsSequentiels.getTaille() &&
+                   statistiques.segments_.size() <= 16 &&
+                   filmPopulaire == analyseurLogsSequentiel.getFilmPlusPopulaire() &&
+                   statistiques.getNombreVuesFilmEntre(filmPopulaire, premierTimestamp, dernierTimestamp) ==
+                       analyseurLogsSequentiel.getNombreVuesFilm(filmPopulaire);
+        });
+        tests.push_back(versionFinale &&
+                        std::count(lecturesCoherentes.begin(), lecturesCoherentes.end(), true) == 4 &&
+                        analyseurLogsConcurrent.logs_.getTimestamps() == logsSequentiels.getTimestamps());
+        afficherResultatTest(16, "AnalyseurLogs lecteurs concurrents", tests.back());
+
+        // Test 17
+        std::vector<std::vector<LigneLog>> lotsProducteurs(4);
+        for (std::size_t j = 0; j < logsSequentiels.getTaille(); j++)
+        {
+            lotsProducteurs[j % lotsProducteurs.size()].push_back(logsSequentiels.getLigneLog(j));
+        }
+        lotsProducteurs[1].push_back(LigneLog{premierTimestamp, idDenseInvalide, 0}); // Utilisateur inexistant
+        AnalyseurLogs analyseurLogsLots;
+        bool lotsAjoutes = analyseurLogsLots.ajouterLotsLog(std::move(lotsProducteurs),
+                                                            gestionnaireUtilisateursFichier,
+                                                            gestionnaireFilmsFichier);
+        // Le classement est mis à jour vue par vue: à nombre de vues égal, l'ordre peut différer du chargement
+        std::vector<std::pair<const Film*, int>> premiersLots = analyseurLogsLots.getNFilmsPlusPopulaires(10);
+        std::vector<std::pair<const Film*, int>> premiersSequentiels =
+            analyseurLogsSequentiel.getNFilmsPlusPopulaires(10);
+        bool memesPremiers = premiersLots.size() == premiersSequentiels.size() &&
+                             analyseurLogsLots.getNombreVuesFilm(analyseurLogsLots.getFilmPlusPopulaire()) ==
+                                 premiersSequentiels.front().second;
+        for (std::size_t j = 0; memesPremiers && j < premiersLots.size(); j++)
+        {
+            memesPremiers = premiersLots[j].second == premiersSequentiels[j].second &&
+                            premiersLots[j].second == analyseurLogsSequentiel.getNombreVuesFilm(premiersLots[j].first);
+        }
+        tests.push_back(!lotsAjoutes && analyseurLogsLots.logs_.getTimestamps() == logsSequentiels.getTimestamps() &&
+                        analyseurLogsLots.logs_.getIdsFilms() == logsSequentiels.getIdsFilms() &&
+                        analyseurLogsLots.vuesFilms_ == analyseurLogsSequentiel.vuesFilms_ && memesPremiers);
+        afficherResultatTest(17, "AnalyseurLogs::ajouterLotsLog", tests.back());
+
+        // Test 18
+        AnalyseurLogs analyseurLogsEgalites;
+        analyseurLogsEgalites.ajouterLigneLog(LigneLog{premierTimestamp, idsUtilisateurs[0], idsFilms[0]},
+                                              gestionnaireUtilisateurs, gestionnaireFilms);
+        analyseurLogsEgalites.ajouterLigneLog(LigneLog{premierTimestamp, idsUtilisateurs[1], idsFilms[0]},
+                                              gestionnaireUtilisateurs, gestionnaireFilms);
+        analyseurLogsEgalites.ajouterLignesLog({LigneLog{premierTimestamp, idsUtilisateurs[2], idsFilms[0]}},
+                                               gestionnaireUtilisateurs, gestionnaireFilms);
+        analyseurLogsEgalites.ajouterLigneLog(LigneLog{premierTimestamp, idsUtilisateurs[3], idsFilms[0]},
+                                              gestionnaireUtilisateurs, gestionnaireFilms);
+        tests.push_back(analyseurLogsEgalites.logs_.getIdsUtilisateurs() ==
+                        std::vector<IdDense>{idsUtilisateurs[0], idsUtilisateurs[1], idsUtilisateurs[2],
+                                             idsUtilisateurs[3]});
+        afficherResultatTest(18, "AnalyseurLogs ordre des timestamps egaux", tests.back());
+
+        // Test 19
+        GestionnaireUtilisateurs utilisateursCompactes(gestionnaireUtilisateurs);
+        GestionnaireFilms filmsCompactes(gestionnaireFilms);
+        AnalyseurLogs analyseurLogsCompacte;
+        static constexpr std::array<std::pair<std::size_t, std::size_t>, 6> vuesCompaction = {
+            {{0, 0}, {1, 1}, {2, 1}, {3, 2}, {4, 2}, {5, 2}}};
+        for (std::size_t i = 0; i < vuesCompaction.size(); i++)
+        {
+            auto [utilisateur, film] = vuesCompaction[i];
+            analyseurLogsCompacte.ajouterLigneLog(
+                LigneLog{premierTimestamp + static_cast<Timestamp>(i), idsUtilisateurs[utilisateur], idsFilms[film]},
+                utilisateursCompactes, filmsCompactes);
+        }
+        filmsCompactes.supprimerFilm("Nom1");
+        utilisateursCompactes.supprimerUtilisateur("prénom.nom.2@email.com");
+        std::vector<IdDense> nouveauxIdsFilms = filmsCompactes.compacterIdsDenses();
+        std::vector<IdDense> nouveauxIdsUtilisateurs = utilisateursCompactes.compacterIdsDenses();
+        std::size_t lignesRetirees = analyseurLogsCompacte.renumeroterIdsDenses(
+            nouveauxIdsUtilisateurs, nouveauxIdsFilms, utilisateursCompactes, filmsCompactes);
+        const Film* filmCompacte = filmsCompactes.getFilmParNom("Nom3");
+        const Utilisateur* utilisateurCompacte = utilisateursCompactes.getUtilisateurParId("prénom.nom.3@email.com");
+        std::vector<std::string_view> nomsDocumentaires;
+        for (const Film* film : filmsCompactes.getVueFilmsParGenre(Film::Genre::Documentaire))
+        {
+            nomsDocumentaires.push_back(film->nom);
+        }
+        tests.push_back(lignesRetirees == 2 && nouveauxIdsFilms[idsFilms[0]] == idDenseInvalide &&
+                        filmsCompactes.getNombreIdsDenses() == nombreFilms - 1 &&
+                        utilisateursCompactes.getNombreIdsDenses() == nombreUtilisateurs - 1 &&
+                        filmCompacte != nullptr && filmCompacte->idDense == 1 && utilisateurCompacte != nullptr &&
+                        utilisateurCompacte->idDense == 1 && analyseurLogsCompacte.logs_.getTaille() == 4 &&
+                        analyseurLogsCompacte.vuesFilms_.size() == nombreFilms - 1 &&
+                        analyseurLogsCompacte.getNombreVuesFilm(filmCompacte) == 3 &&
+                        analyseurLogsCompacte.getFilmPlusPopulaire() == filmCompacte &&
+                        analyseurLogsCompacte.getNombreVuesPourUtilisateur(utilisateurCompacte) == 1 &&
+                        nomsDocumentaires.size() == nombreFilms - 1 && nomsDocumentaires.front() == "Nom2" &&
+                        nomsDocumentaires.back() == "Nom10" && gestionnaireFilms.getFilmParNom("Nom1") != nullptr);
+        afficherResultatTest(19, "Compaction des identifiants denses", tests.back());
+
+        // Test 20
+        AnalyseurLogs analyseurLogsProducteurs;
+        const Film* filmSuivi = analyseurLogsSequentiel.getFilmPlusPopulaire();
+        std::atomic<std::size_t> producteursTermines{0};
+        std::vector<std::thread> threadsProducteurs;
+        for (std::size_t producteur = 0; producteur < 4; producteur++)
+        {
+            threadsProducteurs.emplace_back(
+                [&, producteur](AnalyseurLogs::Producteur producteurLogs) {
+                    for (std::size_t j = producteur; j < logsSequentiels.getTaille(); j += 4)
+                    {
+                        producteurLogs.ajouterLigneLog(logsSequentiels.getLigneLog(j));
+                    }
+                    producteurLogs.transmettre();
+                    producteursTermines.fetch_add(1, std::memory_order_release);
+                },
+                analyseurLogsProducteurs.creerProducteur(gestionnaireUtilisateursFichier, gestionnaireFilmsFichier));
+        }
+        // Les vues sont lues et les lignes intégrées pendant que les producteurs ajoutent
+        bool vuesCroissantes = true;
+        int vuesPrecedentes = 0;
+        while (producteursTermines.load(std::memory_order_acquire) < threadsProducteurs.size())
+        {
+            analyseurLogsProducteurs.integrerLignesProduites();
+            int vuesFilmSuivi = analyseurLogsProducteurs.getNombreVuesFilm(filmSuivi);
+            vuesCroissantes = vuesCroissantes && vuesFilmSuivi >= vuesPrecedentes;
+            vuesPrecedentes = vuesFilmSuivi;
+            std::this_thread::yield();
+        }
+        for (std::thread& thread : threadsProducteurs)
+        {
+            thread.join();
+        }
+        bool vuesAvantIntegration = analyseurLogsProducteurs.getNombreVuesFilm(filmSuivi) ==
+                                    analyseurLogsSequentiel.getNombreVuesFilm(filmSuivi);
+        // Le classement additionne aussi les vues qui n'ont pas encore été intégrées
+        std::vector<std::pair<const Film*, int>> premiersAvantIntegration =
+            analyseurLogsProducteurs.getNFilmsPlusPopulaires(10);
+        bool classementAvantIntegration = analyseurLogsProducteurs.getFilmPlusPopulaire() == filmSuivi &&
+                                          premiersAvantIntegration.size() == 10;
+        for (const auto& [film, nombreVues] : premiersAvantIntegration)
+        {
+            classementAvantIntegration = classementAvantIntegration &&
+                                         nombreVues == analyseurLogsProducteurs.getNombreVuesFilm(film) &&
+                                         nombreVues == analyseurLogsSequentiel.getNombreVuesFilm(film) &&
+                                         nombreVues <= premiersAvantIntegration.front().second;
+        }
+        analyseurLogsProducteurs.integrerLignesProduites();
+        bool vuesUtilisateursIdentiques = true;
+        for (IdDense idUtilisateur = 0; idUtilisateur < gestionnaireUtilisateursFichier.getNombreIdsDenses();
+             idUtilisateur++)
+        {
+            const Utilisateur* utilisateur = gestionnaireUtilisateursFichier.getUtilisateurParIdDense(idUtilisateur);
+            vuesUtilisateursIdentiques =
+                vuesUtilisateursIdentiques && analyseurLogsProducteurs.getNombreVuesPourUtilisateur(utilisateur) ==
+                                                  analyseurLogsSequentiel.getNombreVuesPourUtilisateur(utilisateur);
+        }
+        tests.push_back(vuesCroissantes && vuesAvantIntegration && classementAvantIntegration &&
+                        vuesUtilisateursIdentiques &&
+                        analyseurLogsProducteurs.logs_.getTimestamps() == logsSequentiels.getTimestamps() &&
+                        analyseurLogsProducteurs.vuesFilms_ == analyseurLogsSequentiel.vuesFilms_ &&
+                        analyseurLogsProducteurs.getNombreVuesFilm(filmSuivi) ==
+                            analyseurLogsSequentiel.getNombreVuesFilm(filmSuivi) &&
+                        analyseurLogsProducteurs.getFilmPlusPopulaire() == filmSuivi);
+        afficherResultatTest(20, "AnalyseurLogs producteurs concurrents", tests.back());
+
+        // Test 21
+        // Une plage plus courte que le catalogue est triée, une plage plus longue est comptée par film
+        const Timestamp finPlageCourte = logsSequentiels.getTimestamps()[gestionnaireFilmsFichier.getNombreFilms() / 2];
+        auto verifierPremiersEntre = [&](Timestamp debut, Timestamp fin) {
+            std::vector<std::pair<const Film*, int>> premiers =
+                analyseurLogsSequentiel.getNFilmsPlusPopulairesEntre(5, debut, fin);
+            bool premiersValides = !premiers.empty();
+            for (std::size_t j = 0; premiersValides && j < premiers.size(); j++)
+            {
+                premiersValides = premiers[j].second ==
+                                      analyseurLogsSequentiel.getNombreVuesFilmEntre(premiers[j].first, debut, fin) &&
+                                  (j == 0 || premiers[j - 1].second >= premiers[j].second);
+            }
+            return premiersValides;
+        };
+        std::vector<std::pair<const Film*, int>> premiersTousLogs =
+            analyseurLogsSequentiel.getNFilmsPlusPopulairesEntre(1, premierTimestamp, dernierTimestamp);
+        tests.push_back(verifierPremiersEntre(premierTimestamp, finPlageCourte) &&
+                        verifierPremiersEntre(premierTimestamp, dernierTimestamp) && premiersTousLogs.size() == 1 &&
+                        premiersTousLogs.front().second ==
+                            analyseurLogsSequentiel.getNombreVuesFilm(analyseurLogsSequentiel.getFilmPlusPopulaire()));
+        afficherResultatTest(21, "AnalyseurLogs populaires sur courtes plages", tests.back());
+
         int nombreTestsReussis = static_cast<int>(std::count(tests.begin(), tests.end(), true));
         double totalPointsSection =
             static_cast<double>(nombreTestsReussis) / static_cast<double>(tests.size()) * maxPointsSection;
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include "AnalyseurLogs.h"
+#include "Benchmarks.h"
 #include "GestionnaireFilms.h"
 #include "GestionnaireUtilisateurs.h"
 #include "Tests.h"
@@ -17,6 +18,7 @@ int main()
     initializeConsole();
 
     Tests::testAll();
+    Benchmarks::benchAll();
 
     // Écrivez le code pour le bonus ici
 	GestionnaireUtilisateurs gestionnaireUtilisateurs;
@@ -25,26 +27,26 @@ int main()
 	gestionnaireFilms.chargerDepuisFichier("films.txt");
 	AnalyseurLogs analyseurLogs;
 	analyseurLogs.chargerDepuisFichier("logs.txt", gestionnaireUtilisateurs, gestionnaireFilms);
-	std::cout << std::endl << gestionnaireUtilisateurs << std::endl;
-	std::cout << "Films d'aventure:" << std::endl;
-	for (const auto& element : gestionnaireFilms.getFilmsParGenre(Film::Genre::Aventure))
+	std::cout << '\n' << gestionnaireUtilisateurs << '\n';
+	std::cout << "Films d'aventure:" << '\n';
+	for (const auto& element : gestionnaireFilms.getVueFilmsParGenre(Film::Genre::Aventure))
 	{
 		std::cout << '\t' << *element << '\n';
 	}
-	std::cout << std::endl << "Films produits de 1960 à 1961: " << std::endl;
-	for (const auto& element : gestionnaireFilms.getFilmsEntreAnnees(1960, 1961))
+	std::cout << '\n' << "Films produits de 1960 à 1961: " << '\n';
+	for (const auto& element : gestionnaireFilms.getVueFilmsEntreAnnees(1960, 1961))
 	{
-		std::cout << '\t' << *(element) << std::endl;
+		std::cout << '\t' << *(element) << '\n';
 	}
 	const Film* filmPopulaire = analyseurLogs.getFilmPlusPopulaire();
-	std::cout << std::endl << "Film le plus populaire(" << analyseurLogs.getNombreVuesFilm(filmPopulaire) << " vues) : "
-		<< *filmPopulaire << std::endl;
-	std::cout << std::endl << "5 films les plus populaires: " << std::endl;
+	std::cout << '\n' << "Film le plus populaire(" << analyseurLogs.getNombreVuesFilm(filmPopulaire) << " vues) : "
+		<< *filmPopulaire << '\n';
+	std::cout << '\n' << "5 films les plus populaires: " << '\n';
 	for (const auto& element : analyseurLogs.getNFilmsPlusPopulaires(5))
 	{
 		std::cout << '\t' << *(element.first) << " (" << element.second << " vues)" << '\n';
 	}
 	const std::string id = "karasik@msn.com";
 	const Utilisateur* utilisateur = gestionnaireUtilisateurs.getUtilisateurParId(id);
-	std::cout << std::endl << "Nombre de films vus par l'utilisateur " << id << ": " << analyseurLogs.getNombreVuesPourUtilisateur(utilisateur) << std::endl;
+	std::cout << '\n' << "Nombre de films vus par l'utilisateur " << id << ": " << analyseurLogs.getNombreVuesPourUtilisateur(utilisateur) << '\n';
 }